@@ -27,7 +27,7 @@ namespace chss::debug {
 
 [[nodiscard]] constexpr std::string_view PositionToString(const Position position) {
 	// clang-format off
-	constexpr auto kPositionNames = matrix::Matrix2D<std::string_view, matrix::Size2D{.sizeX = 8, .sizeY = 8}>(
+	constexpr auto kPositionNames = matrix::Matrix2D<std::string_view, matrix::Size2D{.sizeY = 8, .sizeX = 8}>(
 		std::array<std::string_view, 64>{
 			"a1", "b1", "c1", "d1", "e1", "f1", "g1", "h1",
 			"a2", "b2", "c2", "d2", "e2", "f2", "g2", "h2",
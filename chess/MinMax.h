@@ -1,109 +1,1201 @@
 #pragma once
 
 #include "evaluation/Evaluation.h"
+#include "evaluation/SEE.h"
+#include "move_generation/GivesCheck.h"
+#include "move_generation/IsInCheck.h"
+#include "move_generation/IsLegal.h"
 #include "move_generation/LegalMoves.h"
+#include "move_generation/MakeMove.h"
 #include "representation/Move.h"
 #include "representation/State.h"
+#include "search/ThreadData.h"
+#include "search/TranspositionTable.h"
+#include "search/Zobrist.h"
 
-#include <concurrency/TaskQueue.h>
+#include <cpp_utils/StaticVector.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace chss::search {
 
-[[nodiscard]] constexpr int Search(const chss::State& state, int depth, const std::atomic_flag& stop) {
-	if (depth == 0) {
-		return chss::evaluation::Evaluate(state.board);
-	}
-	int result =
-		state.activeColor == chss::Color::White ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+// Larger than any evaluation (the values of the kings cancel each other), and it fits in a transposition table entry.
+constexpr int kInfinity = 32000;
+
+// Score of drawn positions (stalemate, repetitions and the fifty-move rule).
+constexpr int kDraw = 0;
+
+// Score of being checkmated at the root. Being checkmated at a given ply scores -kMate + ply, so the side that mates
+// prefers the shortest mate, and the side that gets mated the longest one.
+constexpr int kMate = 31000;
+// Scores beyond this, in absolute value, are mates (no mate is found deeper than kMaxPly).
+constexpr int kMateInMaxPly = kMate - kMaxPly;
+
+// Score of mating in the given number of plies from the root.
+[[nodiscard]] constexpr int MateIn(const int ply) {
+	return kMate - ply;
+}
+
+// Score of getting mated in the given number of plies from the root.
+[[nodiscard]] constexpr int MatedIn(const int ply) {
+	return -kMate + ply;
+}
+
+[[nodiscard]] constexpr bool IsMateScore(const int score) {
+	return score >= kMateInMaxPly || score <= -kMateInMaxPly;
+}
+
+// Moves (not plies) until the mate of a mate score: positive if the side to move at the root mates, negative if it
+// gets mated. For example, 1 for MateIn(1), and -1 for MatedIn(2).
+[[nodiscard]] constexpr int MateInMoves(const int score) {
+	return score > 0 ? (kMate - score + 1) / 2 : -(kMate + score) / 2;
+}
+
+// Plies without captures or pawn moves after which the game is drawn.
+constexpr int kFiftyMoveRulePlies = 100;
+
+constexpr auto kNoMove =
+	Move{.from = Position{.y = -1, .x = -1}, .to = Position{.y = -1, .x = -1}, .promotionType = std::nullopt};
+
+} // namespace chss::search
+
+namespace detail {
+
+// Legal moves of the position, with the move suggested by the transposition table (if any) in the first place.
+[[nodiscard]] inline chss::search::MoveList GenerateOrderedMoves(
+	const chss::State& state,
+	const std::optional<chss::Move>& ttMove) {
+	auto moves = chss::search::MoveList();
 	for (const auto move : chss::move_generation::LegalMoves(state)) {
-		if !consteval {
-			if (stop.test()) {
-				break;
+		moves.PushBack(move);
+		if (move == ttMove) {
+			std::swap(moves[0], moves[moves.GetSize() - 1]);
+		}
+	}
+	return moves;
+}
+
+// Lazy SMP: helper threads skip some depths of the iterative deepening, so that they do not all search the same
+// iteration at the same time, and they fill the shared transposition table with results of different depths.
+constexpr auto kSkipSize = std::array<int, 20>{1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+constexpr auto kSkipPhase = std::array<int, 20>{0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+[[nodiscard]] constexpr bool IsDepthSkipped(const int threadId, const int depth) {
+	if (threadId == 0) {
+		return false;
+	}
+	const auto i = static_cast<std::size_t>((threadId - 1) % 20);
+	return ((depth + kSkipPhase[i]) / kSkipSize[i]) % 2 != 0;
+}
+
+[[nodiscard]] constexpr int EvaluateForActiveColor(const chss::State& state) {
+	const auto evaluation = chss::evaluation::Evaluate(state.board);
+	return state.activeColor == chss::Color::White ? evaluation : -evaluation;
+}
+
+// EvaluateForActiveColor, when the active color is known at compile time.
+template<chss::Color kColor>
+[[nodiscard]] constexpr int EvaluateFor(const chss::State& state) {
+	const auto evaluation = chss::evaluation::Evaluate(state.board);
+	return kColor == chss::Color::White ? evaluation : -evaluation;
+}
+
+[[nodiscard]] constexpr bool IsActiveColorInCheck(const chss::State& state) {
+	return chss::move_generation::IsInCheck(
+		state.board,
+		state.activeColor,
+		chss::move_generation::FindKing(state.board, state.activeColor));
+}
+
+template<chss::Color kColor>
+[[nodiscard]] constexpr bool IsInCheck(const chss::State& state) {
+	return chss::move_generation::IsInCheck<kColor>(state.board, chss::move_generation::FindKing(state.board, kColor));
+}
+
+// Type of the piece that the move captures, if any.
+[[nodiscard]] constexpr std::optional<chss::PieceType> CapturedType(const chss::State& state, const chss::Move& move) {
+	const auto& target = state.board.At(move.to);
+	if (target.has_value()) {
+		return target->type;
+	}
+	if (move.from.x != move.to.x && state.board.At(move.from).value().type == chss::PieceType::Pawn) {
+		return chss::PieceType::Pawn; // En passant.
+	}
+	return std::nullopt;
+}
+
+// After fifty moves without captures or pawn moves the game is drawn, unless the last move was checkmate.
+[[nodiscard]] constexpr bool IsFiftyMoveDraw(const chss::State& state) {
+	if (state.halfmoveClock < chss::search::kFiftyMoveRulePlies) {
+		return false;
+	}
+	const auto moves = chss::move_generation::LegalMoves(state);
+	return !IsActiveColorInCheck(state) || moves.begin() != moves.end();
+}
+
+/**
+ * Whether the position (its key) appeared before in the search path or in the game. Only the last halfmoveClock plies
+ * can contain it (the position before an irreversible move never comes back), and the scan also stops at null moves,
+ * which are not real moves. A single repetition counts as a draw: if the position repeats once, it can repeat again.
+ */
+[[nodiscard]] inline bool IsRepetition(
+	const std::uint64_t key,
+	const int halfmoveClock,
+	const int ply,
+	const chss::search::ThreadData& threadData) {
+	const auto& stack = threadData.stack;
+	const auto& gameKeys = threadData.gameKeys;
+	const auto rootPly = threadData.rootPly;
+	for (int distance = 1; distance <= halfmoveClock; ++distance) {
+		const auto previousPly = ply - distance;
+		if (previousPly >= rootPly && stack[previousPly].isNullMove) {
+			return false;
+		}
+		if (previousPly < rootPly && static_cast<std::size_t>(rootPly - previousPly) > gameKeys.size()) {
+			return false;
+		}
+		// Only the positions with the same side to move can be the same.
+		if (distance % 2 == 0) {
+			const auto previousKey =
+				previousPly >= rootPly ? stack[previousPly].key : gameKeys.end()[previousPly - rootPly];
+			if (previousKey == key) {
+				return true;
 			}
 		}
-		const auto newState = chss::move_generation::MakeMove(state, move);
-		const auto score = Search(newState, depth - 1, stop);
-		if (state.activeColor == chss::Color::White) {
-			result = std::max(result, score);
-		} else {
-			result = std::min(result, score);
+	}
+	return false;
+}
+
+// Mate scores are relative to the root, but the transposition table stores them relative to the node (mate in so many
+// plies from the node), so that they remain right when the node is reached at another ply.
+[[nodiscard]] constexpr int ScoreToTranspositionTable(const int score, const int ply) {
+	if (score >= chss::search::kMateInMaxPly) {
+		return score + ply;
+	}
+	if (score <= -chss::search::kMateInMaxPly) {
+		return score - ply;
+	}
+	return score;
+}
+
+[[nodiscard]] constexpr int ScoreFromTranspositionTable(const int score, const int ply) {
+	if (score >= chss::search::kMateInMaxPly) {
+		return score - ply;
+	}
+	if (score <= -chss::search::kMateInMaxPly) {
+		return score + ply;
+	}
+	return score;
+}
+
+// Neither a capture nor a promotion.
+[[nodiscard]] constexpr bool IsQuiet(const chss::State& state, const chss::Move& move) {
+	return !move.promotionType.has_value() && !CapturedType(state, move).has_value();
+}
+
+[[nodiscard]] constexpr chss::search::PieceToSquare GetPieceToSquare(const chss::State& state, const chss::Move& move) {
+	return chss::search::PieceToSquare{.piece = state.board.At(move.from).value(), .to = move.to};
+}
+
+// Null-move pruning is not tried in positions where passing could be the best move (zugzwang), which are typical of
+// endings where the side to move has only pawns, or only pawns and a minor piece.
+[[nodiscard]] constexpr bool IsZugzwangUnlikely(const chss::Board& board, const chss::Color color) {
+	int nonPawnMaterial = 0;
+	for (const auto position : ForEach(board.GetSize())) {
+		const auto& pieceOpt = board.At(position);
+		if (pieceOpt.has_value() && pieceOpt.value().color == color && pieceOpt.value().type != chss::PieceType::Pawn &&
+			pieceOpt.value().type != chss::PieceType::King) {
+			nonPawnMaterial += chss::evaluation::PieceValue(pieceOpt.value().type);
 		}
 	}
-	return result;
+	return nonPawnMaterial > chss::evaluation::PieceValue(chss::PieceType::Bishop);
+}
+
+// The null-move search is shallower for deeper nodes, and for nodes whose static evaluation is well above beta.
+[[nodiscard]] constexpr int NullMoveReduction(const int depth, const int evaluationMargin) {
+	return 2 + depth / 4 + std::min(evaluationMargin / 200, 2);
+}
+
+// Base late move reduction, indexed by depth and move index: log(depth) * log(moveIndex) / 2.25, rounded.
+inline const auto kLateMoveReductions = []() {
+	auto reductions = std::array<std::array<int, 64>, 64>();
+	for (std::size_t depth = 1; depth < 64; ++depth) {
+		for (std::size_t moveIndex = 1; moveIndex < 64; ++moveIndex) {
+			reductions[depth][moveIndex] = static_cast<int>(
+				0.75 + std::log(static_cast<double>(depth)) * std::log(static_cast<double>(moveIndex)) / 2.25);
+		}
+	}
+	return reductions;
+}();
+
+// Moves with a good history get reduced less, and moves with a bad history more (see QuietHistory). The reduced search
+// is at least one ply deep.
+[[nodiscard]] inline int LateMoveReduction(
+	const int depth,
+	const std::size_t moveIndex,
+	const int history,
+	const bool isPvNode) {
+	auto reduction = kLateMoveReductions[std::min(depth, 63)][std::min<std::size_t>(moveIndex, 63)];
+	reduction -= history / chss::search::kMaxHistory;
+	if (isPvNode) {
+		--reduction;
+	}
+	return std::clamp(reduction, 0, depth - 2);
+}
+
+// History of a quiet move: its butterfly history plus its continuation histories after the moves one and two plies
+// before (when they were not null moves).
+[[nodiscard]] inline int QuietHistory(
+	const chss::State& state,
+	const chss::Move& move,
+	const int ply,
+	const chss::search::ThreadData& threadData) {
+	const auto& histories = *threadData.histories;
+	const auto current = GetPieceToSquare(state, move);
+	auto history = histories.butterfly.Get(state.activeColor, move);
+	for (const int previousPly : {ply - 1, ply - 2}) {
+		if (previousPly >= 0 && threadData.stack[previousPly].pieceToSquare.has_value()) {
+			history += histories.continuation.Get(threadData.stack[previousPly].pieceToSquare.value(), current);
+		}
+	}
+	return history;
 }
 
-[[nodiscard]] constexpr std::pair<int, chss::Move> SearchMove(
+inline void UpdateQuietHistories(
 	const chss::State& state,
+	const chss::Move& move,
+	const int ply,
+	const int bonus,
+	chss::search::ThreadData& threadData) {
+	auto& histories = *threadData.histories;
+	const auto current = GetPieceToSquare(state, move);
+	histories.butterfly.Update(state.activeColor, move, bonus);
+	for (const int previousPly : {ply - 1, ply - 2}) {
+		if (previousPly >= 0 && threadData.stack[previousPly].pieceToSquare.has_value()) {
+			histories.continuation.Update(threadData.stack[previousPly].pieceToSquare.value(), current, bonus);
+		}
+	}
+}
+
+// Rewards the move that caused a beta cutoff, and penalizes the quiet moves or captures searched before it (the ones in
+// the quietMoves and captureMoves of the ply).
+inline void UpdateHistoriesAfterCutoff(
+	const chss::State& state,
+	const chss::Move& move,
+	const int depth,
+	const int ply,
+	chss::search::ThreadData& threadData) {
+	const auto bonus = chss::search::HistoryBonus(depth);
+	auto& histories = *threadData.histories;
+	const auto& stack = threadData.stack;
+	if (IsQuiet(state, move)) {
+		UpdateQuietHistories(state, move, ply, bonus, threadData);
+		for (const auto& quietMove : stack[ply].quietMoves) {
+			UpdateQuietHistories(state, quietMove, ply, -bonus, threadData);
+		}
+		if (ply > 0 && stack[ply - 1].pieceToSquare.has_value()) {
+			histories.counterMoves.Set(stack[ply - 1].pieceToSquare.value(), move);
+		}
+	} else if (const auto capturedType = CapturedType(state, move); capturedType.has_value()) {
+		histories.capture.Update(GetPieceToSquare(state, move), capturedType.value(), bonus);
+	}
+	for (const auto& captureMove : stack[ply].captureMoves) {
+		histories.capture.Update(
+			GetPieceToSquare(state, captureMove),
+			CapturedType(state, captureMove).value(),
+			-bonus);
+	}
+}
+
+// Scores of the move ordering. History scores stay well within the gaps between them.
+constexpr int kTtMoveScore = 1 << 30;
+constexpr int kGoodCaptureScore = 1 << 28;
+constexpr int kCounterMoveScore = 1 << 26;
+constexpr int kBadCaptureScore = -(1 << 28);
+// Weight of the value of the captured piece, so that it matters more than the capture history.
+constexpr int kVictimValueWeight = 32;
+
+[[nodiscard]] inline int ScoreMove(
+	const chss::State& state,
+	const chss::Move& move,
+	const std::optional<chss::Move>& ttMove,
+	const std::optional<chss::Move>& counterMove,
+	const int ply,
+	const chss::search::ThreadData& threadData) {
+	if (move == ttMove) {
+		return kTtMoveScore;
+	}
+	const auto capturedType = CapturedType(state, move);
+	if (!capturedType.has_value() && !move.promotionType.has_value()) {
+		return move == counterMove ? kCounterMoveScore : QuietHistory(state, move, ply, threadData);
+	}
+	int score = chss::evaluation::SEEGreaterOrEqual(state, move, 0) ? kGoodCaptureScore : kBadCaptureScore;
+	if (capturedType.has_value()) {
+		score += kVictimValueWeight * chss::evaluation::PieceValue(capturedType.value()) +
+			threadData.histories->capture.Get(GetPieceToSquare(state, move), capturedType.value());
+	}
+	if (move.promotionType.has_value()) {
+		score += kVictimValueWeight * chss::evaluation::PieceValue(move.promotionType.value());
+	}
+	return score;
+}
+
+/**
+ * Legal moves of the position, in the order in which the search tries them: the transposition table move, the captures
+ * and promotions that do not lose material (most valuable victim first, then by capture history), the counter move of
+ * the previous move, the other quiet moves by history (see QuietHistory), and the captures that lose material.
+ *
+ * They go to the search stack entry of the ply, which the result refers to. kColor is the active color of the state.
+ */
+template<chss::Color kColor>
+const chss::search::MoveList& GenerateSortedMoves(
+	const chss::State& state,
+	const std::optional<chss::Move>& ttMove,
+	const int ply,
+	chss::search::ThreadData& threadData) {
+	const auto previous = ply > 0 ? threadData.stack[ply - 1].pieceToSquare : std::nullopt;
+	const auto counterMove =
+		previous.has_value() ? threadData.histories->counterMoves.Get(previous.value()) : std::nullopt;
+	auto& moves = threadData.stack[ply].moves;
+	auto& scores = threadData.stack[ply].moveScores;
+	moves.Clear();
+	for (const auto move : chss::move_generation::LegalMoves<kColor>(state)) {
+		// Insertion sort: stable, and fast enough for the length of the lists.
+		const auto score = ScoreMove(state, move, ttMove, counterMove, ply, threadData);
+		auto i = moves.GetSize();
+		moves.PushBack(move);
+		for (; i > 0 && scores[i - 1] < score; --i) {
+			moves[i] = moves[i - 1];
+			scores[i] = scores[i - 1];
+		}
+		moves[i] = move;
+		scores[i] = score;
+	}
+	return moves;
+}
+
+} // namespace detail
+
+namespace chss::search {
+
+/**
+ * The kinds of nodes of Search. Each one is a separate instantiation of SearchNode, so that the null-window nodes,
+ * which are almost all of the tree, do not test for the work that only the principal variation needs. The root has its
+ * own function, SearchRoot.
+ */
+enum class NodeType : std::uint8_t {
+	// Searched with an open window: it keeps its principal variation, and is never pruned by margins.
+	PV,
+	// Searched with a null window, to prove a bound.
+	NonPV
+};
+
+template<NodeType kNodeType, Color kColor>
+[[nodiscard]] int SearchNode(const State& state, int depth, int ply, int alpha, int beta, ThreadData& threadData);
+
+template<Color kColor>
+[[nodiscard]] int SearchWithWindow(const State& state, int depth, int ply, int alpha, int beta, ThreadData& threadData);
+
+[[nodiscard]] int Search(const State& state, int depth, int ply, int alpha, int beta, ThreadData& threadData);
+
+/**
+ * Quiescence search: only captures and promotions that do not lose material (according to SEE), until the position is
+ * quiet. The side to move can always stand pat with the static evaluation (checks are not resolved, to keep it cheap).
+ * The score is relative to the side to move, which is kColor.
+ */
+template<Color kColor>
+[[nodiscard]] int Quiescence(const State& state, int alpha, const int beta, ThreadData& threadData) {
+	if (threadData.IsStopped()) {
+		return 0;
+	}
+	++threadData.nodes;
+	++threadData.stats.quiescenceNodes;
+	int bestScore = detail::EvaluateFor<kColor>(state);
+	if (bestScore >= beta) {
+		return bestScore;
+	}
+	alpha = std::max(alpha, bestScore);
+	for (const auto move : move_generation::LegalMoves<kColor>(state)) {
+		if (detail::IsQuiet(state, move) || !evaluation::SEEGreaterOrEqual(state, move, 0)) {
+			continue;
+		}
+		const auto score = -Quiescence<InverseColor(kColor)>(
+			move_generation::MakeMove<kColor>(state, move),
+			-beta,
+			-alpha,
+			threadData);
+		if (threadData.IsStopped()) {
+			return 0;
+		}
+		if (score > bestScore) {
+			bestScore = score;
+			if (score > alpha) {
+				alpha = score;
+				if (alpha >= beta) {
+					break;
+				}
+			}
+		}
+	}
+	return bestScore;
+}
+
+[[nodiscard]] inline int Quiescence(const State& state, const int alpha, const int beta, ThreadData& threadData) {
+	if (state.activeColor == Color::White) {
+		return Quiescence<Color::White>(state, alpha, beta, threadData);
+	}
+	return Quiescence<Color::Black>(state, alpha, beta, threadData);
+}
+
+} // namespace chss::search
+
+namespace detail {
+
+// Principal variation search of a move that is not the first one: a null-window search proves that the move is not
+// better than alpha, and only if that fails the move gets searched again with the full window. With a reduction, the
+// null-window search is first tried that much shallower. Returns the score from the point of view of the parent.
+// kColor is the side to move of newState.
+template<chss::Color kColor>
+[[nodiscard]] int ScoutAndReSearch(
+	const chss::State& newState,
+	const int depth,
+	const int ply,
+	const int reduction,
+	const int alpha,
+	const int beta,
+	chss::search::ThreadData& threadData) {
+	if (reduction > 0) {
+		++threadData.stats.lateMoveReductions;
+		const auto score = -chss::search::SearchNode<chss::search::NodeType::NonPV, kColor>(
+			newState,
+			depth - reduction,
+			ply,
+			-alpha - 1,
+			-alpha,
+			threadData);
+		if (score <= alpha || threadData.IsStopped()) {
+			return score;
+		}
+		++threadData.stats.lateMoveReSearches;
+	}
+	const auto score = -chss::search::SearchNode<chss::search::NodeType::NonPV, kColor>(
+		newState,
+		depth,
+		ply,
+		-alpha - 1,
+		-alpha,
+		threadData);
+	if (score <= alpha || score >= beta || threadData.IsStopped()) {
+		return score;
+	}
+	++threadData.stats.pvsReSearches;
+	// alpha < score < beta, so the window is open.
+	return -chss::search::SearchNode<chss::search::NodeType::PV, kColor>(
+		newState,
+		depth,
+		ply,
+		-beta,
+		-alpha,
+		threadData);
+}
+
+// Extensions are limited to half of the plies of the path (one every two plies on average), so an extended search
+// still gets shallower and ends.
+[[nodiscard]] inline bool IsExtensionAllowed(const chss::search::SearchStack& stack, const int ply) {
+	return 2 * (stack[ply].extensions + 1) <= ply + 1;
+}
+
+// The principal variation of a PV node whose best move so far is the given one: the move, and the principal variation
+// of the child that it leads to.
+inline void UpdatePrincipalVariation(chss::search::SearchStack& stack, const int ply, const chss::Move& move) {
+	auto& principalVariation = stack[ply].principalVariation;
+	principalVariation.Clear();
+	principalVariation.PushBack(move);
+	for (const auto& childMove : stack[ply + 1].principalVariation) {
+		principalVariation.PushBack(childMove);
+	}
+}
+
+} // namespace detail
+
+namespace chss::search {
+
+// Null-move pruning and late move reductions start at this depth.
+constexpr int kNullMoveMinDepth = 3;
+constexpr int kLateMoveReductionMinDepth = 3;
+// The first moves (the transposition table move and the first generated ones) are never reduced.
+constexpr std::size_t kLateMoveReductionMinMoveIndex = 3;
+// Frontier pruning (see PruningMargins) happens at this depth and below.
+constexpr int kFrontierPruningMaxDepth = 3;
+// The transposition table move is tested for singularity from this depth, if the table searched it at least this deep
+// minus kSingularExtensionMaxDepthDifference. It is singular if all the other moves fail low against its score minus
+// kSingularMarginPerDepth * depth.
+constexpr int kSingularExtensionMinDepth = 6;
+constexpr int kSingularExtensionMaxDepthDifference = 3;
+constexpr int kSingularMarginPerDepth = 10;
+// ProbCut: from this depth, captures that are likely to beat beta by kProbCutMargin get a search kProbCutDepthReduction
+// plies shallower, and if one of them does, the node is pruned.
+constexpr int kProbCutMinDepth = 5;
+constexpr int kProbCutMargin = 200;
+constexpr int kProbCutDepthReduction = 4;
+// PV and cut nodes without a transposition table move, from this depth, are reduced or searched first this many plies
+// shallower (see InternalIteration).
+constexpr int kInternalIterationMinDepth = 4;
+constexpr int kInternalIterativeDeepeningReduction = 2;
+
+/**
+ * Negamax principal variation search (fail-soft alpha-beta that scouts all the moves but the first one with a null
+ * window). The score is relative to the side to move. ply is the distance to the root, which indexes the search stack
+ * of the thread.
+ *
+ * Outside of the principal variation, it tries null-move pruning: if passing the turn still fails high with a reduced
+ * search, the node is pruned. Near the leaves, it also prunes with margins on the static evaluation (reverse futility,
+ * razoring, futility and late-move pruning, see PruningMargins). Late quiet moves are searched with a reduction first
+ * (see detail::LateMoveReduction). Moves are tried in the order of detail::GenerateSortedMoves, and the moves that
+ * cause beta cutoffs update the history tables of the thread.
+ *
+ * Deep enough nodes try ProbCut: a shallow search of the good captures against a raised beta predicts that the full
+ * search would fail high.
+ *
+ * Moves that give check, and transposition table moves that are singular (much better than all the others, according
+ * to an exclusion search), are searched one ply deeper (see detail::IsExtensionAllowed).
+ *
+ * PV and cut nodes without a transposition table move get reduced by one ply, or get a shallower search first that
+ * finds them one (see InternalIteration).
+ *
+ * Positions that repeat one of the game or of the search path (see ThreadData::gameKeys), and positions drawn by the
+ * fifty-move rule, are draws without searching them. Checkmates score MatedIn(ply), and stalemates kDraw.
+ *
+ * The result is meaningless if the search was stopped.
+ *
+ * SearchNode is instantiated per NodeType (which must match the window: open for PV nodes, null for the others) and per
+ * side to move (kColor, the active color of state). Search picks the instantiation at run time.
+ */
+template<NodeType kNodeType, Color kColor>
+[[nodiscard]] int SearchNode(
+	const State& state,
 	int depth,
-	const std::atomic_flag& stop) {
-	assert(depth > 0);
-	auto resultScore =
-		state.activeColor == chss::Color::White ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
-	auto resultMove = chss::Move{.from = chss::Position{.y = -1, .x = -1}, .to = chss::Position{.y = -1, .x = -1}};
-	for (const auto move : chss::move_generation::LegalMoves(state)) {
-		if !consteval {
-			if (stop.test()) {
+	const int ply,
+	int alpha,
+	int beta,
+	ThreadData& threadData) {
+	constexpr auto isPvNode = kNodeType == NodeType::PV;
+	constexpr auto kOpponent = InverseColor(kColor);
+	assert(state.activeColor == kColor);
+	assert(isPvNode == (beta - alpha > 1));
+	auto& stack = threadData.stack;
+	if constexpr (isPvNode) {
+		stack[ply].principalVariation.Clear();
+	}
+	if (threadData.IsStopped()) {
+		return 0;
+	}
+	++threadData.nodes;
+	threadData.selDepth = std::max(threadData.selDepth, ply);
+	if (threadData.reporter != nullptr && threadData.nodes % kProgressReportNodes == 0) {
+		threadData.reporter->ReportProgress();
+	}
+	// The leaves only need the key to look for repetitions, which take at least four reversible plies.
+	const auto key = depth > 0 || state.halfmoveClock >= 4 ? zobrist::Hash(state) : 0;
+	stack[ply].key = key;
+	if (ply > 0 &&
+		(detail::IsRepetition(key, state.halfmoveClock, ply, threadData) || detail::IsFiftyMoveDraw(state))) {
+		return kDraw;
+	}
+	if (depth == 0 || ply >= kMaxPly) {
+		return detail::EvaluateFor<kColor>(state);
+	}
+	if (threadData.options.useMateDistancePruning) {
+		// Mate distance pruning: no mate from here can be shorter than getting mated right here, or than mating with
+		// the next move. If a shorter one is already known, nothing here can matter.
+		alpha = std::max(alpha, MatedIn(ply));
+		beta = std::min(beta, MateIn(ply + 1));
+		if (alpha >= beta) {
+			return alpha;
+		}
+	}
+	const auto isAfterNullMove = ply > 0 && stack[ply - 1].isNullMove;
+	const auto excludedMove = stack[ply].excludedMove;
+	stack[ply + 1].Reset();
+
+	// The result of an exclusion search is not the result of the position, so it does not use the table.
+	auto* transpositionTable = excludedMove.has_value() ? nullptr : threadData.transpositionTable;
+	auto ttEntryOpt = transpositionTable != nullptr ? transpositionTable->Probe(key) : std::nullopt;
+	if (ttEntryOpt.has_value()) {
+		ttEntryOpt->score = detail::ScoreFromTranspositionTable(ttEntryOpt->score, ply);
+	}
+	if (ttEntryOpt.has_value() && ttEntryOpt->depth >= depth) {
+		const auto& ttEntry = ttEntryOpt.value();
+		if (ttEntry.bound == Bound::Exact || (ttEntry.bound == Bound::Lower && ttEntry.score >= beta) ||
+			(ttEntry.bound == Bound::Upper && ttEntry.score <= alpha)) {
+			return ttEntry.score;
+		}
+	}
+
+	const auto isInCheck = detail::IsInCheck<kColor>(state);
+	const auto staticEvaluation = isPvNode || isInCheck ? -kInfinity : detail::EvaluateFor<kColor>(state);
+	const auto& margins = threadData.options.pruningMargins;
+	const auto isFrontierPruningAllowed = threadData.options.useFrontierPruning && !isPvNode && !isInCheck &&
+		!excludedMove.has_value() && depth <= kFrontierPruningMaxDepth && !IsMateScore(alpha) && !IsMateScore(beta);
+	if (isFrontierPruningAllowed) {
+		if (staticEvaluation - margins.reverseFutility[depth] >= beta) {
+			++threadData.stats.reverseFutilityPrunes;
+			return staticEvaluation;
+		}
+		if (staticEvaluation + margins.razoring[depth] <= alpha) {
+			const auto score = Quiescence<kColor>(state, alpha, alpha + 1, threadData);
+			if (threadData.IsStopped()) {
+				return 0;
+			}
+			if (score <= alpha) {
+				++threadData.stats.razoringPrunes;
+				return score;
+			}
+		}
+	}
+
+	if (threadData.options.useNullMovePruning && !isPvNode && !isAfterNullMove && !isInCheck &&
+		!excludedMove.has_value() && depth >= kNullMoveMinDepth && beta < kMateInMaxPly &&
+		detail::IsZugzwangUnlikely(state.board, kColor)) {
+		if (staticEvaluation >= beta) {
+			const auto reduction = detail::NullMoveReduction(depth, staticEvaluation - beta);
+			++threadData.stats.nullMoveTries;
+			stack[ply].isNullMove = true;
+			stack[ply].pieceToSquare = std::nullopt;
+			stack[ply + 1].extensions = stack[ply].extensions;
+			stack[ply + 1].isCutNode = false;
+			const auto score = -SearchNode<NodeType::NonPV, kOpponent>(
+				move_generation::MakeNullMove(state),
+				std::max(depth - 1 - reduction, 0),
+				ply + 1,
+				-beta,
+				-beta + 1,
+				threadData);
+			stack[ply].isNullMove = false;
+			if (threadData.IsStopped()) {
+				return 0;
+			}
+			if (score >= beta) {
+				++threadData.stats.nullMoveCutoffs;
+				// A mate found after passing is not a real mate.
+				return IsMateScore(score) ? beta : score;
+			}
+		}
+	}
+
+	auto ttMove = ttEntryOpt.has_value() ? ttEntryOpt->move : std::nullopt;
+	// Without a table there is never a move to try first, and nothing to learn from the shallower search.
+	if (transpositionTable != nullptr && !ttMove.has_value() && (isPvNode || stack[ply].isCutNode) &&
+		depth >= kInternalIterationMinDepth) {
+		if (threadData.options.internalIteration == InternalIteration::Reductions) {
+			++threadData.stats.internalIterativeReductions;
+			--depth;
+		} else if (threadData.options.internalIteration == InternalIteration::Deepening) {
+			++threadData.stats.internalIterativeDeepenings;
+			// Mate distance pruning can have closed the window of a PV node.
+			std::ignore = SearchWithWindow<kColor>(
+				state,
+				depth - kInternalIterativeDeepeningReduction,
+				ply,
+				alpha,
+				beta,
+				threadData);
+			if (threadData.IsStopped()) {
+				return 0;
+			}
+			const auto iidEntryOpt = transpositionTable->Probe(key);
+			ttMove = iidEntryOpt.has_value() ? iidEntryOpt->move : std::nullopt;
+		}
+	}
+	// The moves live in the stack entry of the ply, until a search of the same ply (a singular exclusion search)
+	// replaces them.
+	const auto* moves = &detail::GenerateSortedMoves<kColor>(state, ttMove, ply, threadData);
+	if (moves->IsEmpty()) {
+		return isInCheck ? MatedIn(ply) : kDraw;
+	}
+
+	auto isProbCutPending = false;
+	if (threadData.options.useProbCut && !isPvNode && !isInCheck && !excludedMove.has_value() &&
+		depth >= kProbCutMinDepth && std::abs(beta) < kMateInMaxPly - kProbCutMargin) {
+		const auto probCutBeta = beta + kProbCutMargin;
+		++threadData.stats.probCutTries;
+		for (const auto& move : *moves) {
+			// Only the captures that win at least the difference between the static evaluation and the raised beta.
+			if (detail::IsQuiet(state, move) ||
+				!evaluation::SEEGreaterOrEqual(state, move, probCutBeta - staticEvaluation)) {
+				continue;
+			}
+			const auto newState = move_generation::MakeMove<kColor>(state, move);
+			stack[ply].pieceToSquare = detail::GetPieceToSquare(state, move);
+			stack[ply + 1].extensions = stack[ply].extensions;
+			stack[ply + 1].isCutNode = false;
+			// The quiescence search is a cheaper first filter.
+			auto score = -Quiescence<kOpponent>(newState, -probCutBeta, -probCutBeta + 1, threadData);
+			if (score >= probCutBeta) {
+				score = -SearchNode<NodeType::NonPV, kOpponent>(
+					newState,
+					depth - kProbCutDepthReduction,
+					ply + 1,
+					-probCutBeta,
+					-probCutBeta + 1,
+					threadData);
+			}
+			if (threadData.IsStopped()) {
+				return 0;
+			}
+			if (score >= probCutBeta) {
+				++threadData.stats.probCutCutoffs;
+				if (!threadData.options.verifyProbCut) {
+					return score;
+				}
+				// Search the node anyway, to know whether the prediction holds.
+				isProbCutPending = true;
 				break;
 			}
 		}
-		const auto newState = chss::move_generation::MakeMove(state, move);
-		const auto score = Search(newState, depth - 1, stop);
-		if (state.activeColor == chss::Color::White) {
-			if (score > resultScore) {
-				resultScore = score;
-				resultMove = move;
+	}
+
+	auto isTtMoveSingular = false;
+	// The move found by internal iterative deepening has no table entry with a score to test.
+	if (threadData.options.useExtensions && ttEntryOpt.has_value() && ttEntryOpt->move.has_value() &&
+		depth >= kSingularExtensionMinDepth && ttEntryOpt->depth >= depth - kSingularExtensionMaxDepthDifference &&
+		ttEntryOpt->bound != Bound::Upper && !IsMateScore(ttEntryOpt->score) &&
+		detail::IsExtensionAllowed(stack, ply)) {
+		const auto singularBeta = ttEntryOpt->score - kSingularMarginPerDepth * depth;
+		++threadData.stats.singularSearches;
+		stack[ply].excludedMove = ttMove;
+		const auto score = SearchNode<NodeType::NonPV, kColor>(
+			state,
+			(depth - 1) / 2,
+			ply,
+			singularBeta - 1,
+			singularBeta,
+			threadData);
+		stack[ply].excludedMove = std::nullopt;
+		if (threadData.IsStopped()) {
+			return 0;
+		}
+		isTtMoveSingular = score < singularBeta;
+		moves = &detail::GenerateSortedMoves<kColor>(state, ttMove, ply, threadData);
+	}
+
+	const int originalAlpha = alpha;
+	int bestScore = -kInfinity;
+	auto bestMove = std::optional<Move>();
+	auto& quietMoves = stack[ply].quietMoves;
+	auto& captureMoves = stack[ply].captureMoves;
+	quietMoves.Clear();
+	captureMoves.Clear();
+	if constexpr (isPvNode) {
+		// The internal iterative deepening search of the node left its own.
+		stack[ply].principalVariation.Clear();
+	}
+	const auto checkInfo = move_generation::ComputeCheckInfo<kColor>(state);
+	std::size_t moveIndex = 0;
+	for (const auto& move : *moves) {
+		if (move == excludedMove) {
+			continue;
+		}
+		const auto i = moveIndex++;
+		const auto isQuiet = detail::IsQuiet(state, move);
+		// Known before making the move, so that the pruned moves are never made.
+		const auto givesCheck = move_generation::GivesCheck<kColor>(state, checkInfo, move);
+		if (isFrontierPruningAllowed && i > 0 && isQuiet && !givesCheck) {
+			if (i >= static_cast<std::size_t>(margins.lateMovePruningCounts[depth])) {
+				++threadData.stats.lateMovePrunes;
+				continue;
+			}
+			if (staticEvaluation + margins.futility[depth] <= alpha) {
+				++threadData.stats.futilityPrunes;
+				bestScore = std::max(bestScore, staticEvaluation + margins.futility[depth]);
+				continue;
+			}
+		}
+		int extension = 0;
+		if (threadData.options.useExtensions && detail::IsExtensionAllowed(stack, ply)) {
+			if (isTtMoveSingular && move == ttMove) {
+				extension = 1;
+				++threadData.stats.singularExtensions;
+			} else if (givesCheck) {
+				extension = 1;
+				++threadData.stats.checkExtensions;
+			}
+		}
+		const auto newDepth = depth - 1 + extension;
+		const auto newState = move_generation::MakeMove<kColor>(state, move);
+		stack[ply].pieceToSquare = detail::GetPieceToSquare(state, move);
+		stack[ply + 1].extensions = stack[ply].extensions + extension;
+		// The first move of a cut node is expected to refute it, so its child is an all node, and vice versa. The
+		// children of the scouts are expected to refute them.
+		stack[ply + 1].isCutNode = i == 0 ? !isPvNode && !stack[ply].isCutNode : true;
+		if constexpr (isPvNode) {
+			// The child only sets its principal variation if it is a PV node.
+			stack[ply + 1].principalVariation.Clear();
+		}
+		int score = 0;
+		if (i == 0) {
+			// Mate distance pruning can have closed the window of a PV node.
+			if constexpr (isPvNode) {
+				score = -SearchWithWindow<kOpponent>(newState, newDepth, ply + 1, -beta, -alpha, threadData);
+			} else {
+				score = -SearchNode<NodeType::NonPV, kOpponent>(newState, newDepth, ply + 1, -beta, -alpha, threadData);
 			}
 		} else {
-			if (score < resultScore) {
-				resultScore = score;
-				resultMove = move;
+			int reduction = 0;
+			if (threadData.options.useLateMoveReductions && depth >= kLateMoveReductionMinDepth &&
+				i >= kLateMoveReductionMinMoveIndex && isQuiet && !isInCheck && !givesCheck) {
+				reduction =
+					detail::LateMoveReduction(depth, i, detail::QuietHistory(state, move, ply, threadData), isPvNode);
+			}
+			score =
+				detail::ScoutAndReSearch<kOpponent>(newState, newDepth, ply + 1, reduction, alpha, beta, threadData);
+		}
+		if (threadData.IsStopped()) {
+			return 0;
+		}
+		if (score > bestScore) {
+			bestScore = score;
+			if (score > alpha) {
+				alpha = score;
+				bestMove = move;
+				if constexpr (isPvNode) {
+					detail::UpdatePrincipalVariation(stack, ply, move);
+				}
+				if (alpha >= beta) {
+					if (threadData.options.updateHistories) {
+						detail::UpdateHistoriesAfterCutoff(state, move, depth, ply, threadData);
+					}
+					break;
+				}
 			}
 		}
+		if (isQuiet) {
+			quietMoves.PushBack(move);
+		} else if (detail::CapturedType(state, move).has_value()) {
+			captureMoves.PushBack(move);
+		}
 	}
-	return std::pair<int, chss::Move>(resultScore, resultMove);
+
+	if (isProbCutPending && bestScore >= beta) {
+		++threadData.stats.probCutConfirmed;
+	}
+	if (transpositionTable != nullptr) {
+		const auto bound = bestScore >= beta ? Bound::Lower : (bestScore > originalAlpha ? Bound::Exact : Bound::Upper);
+		transpositionTable->Store(
+			key,
+			TranspositionTableEntry{
+				.depth = depth,
+				.score = detail::ScoreToTranspositionTable(bestScore, ply),
+				.bound = bound,
+				.move = bestMove});
+	}
+	return bestScore;
 }
 
-[[nodiscard]] inline std::pair<int, chss::Move> ParallelSearchMove(
-	const chss::State& state,
+// SearchNode with the node type that the window calls for.
+template<Color kColor>
+[[nodiscard]] int SearchWithWindow(
+	const State& state,
+	const int depth,
+	const int ply,
+	const int alpha,
+	const int beta,
+	ThreadData& threadData) {
+	return beta - alpha > 1 ? SearchNode<NodeType::PV, kColor>(state, depth, ply, alpha, beta, threadData)
+							: SearchNode<NodeType::NonPV, kColor>(state, depth, ply, alpha, beta, threadData);
+}
+
+// SearchNode with the node type and the side to move of the arguments.
+[[nodiscard]] inline int Search(
+	const State& state,
+	const int depth,
+	const int ply,
+	const int alpha,
+	const int beta,
+	ThreadData& threadData) {
+	if (state.activeColor == Color::White) {
+		return SearchWithWindow<Color::White>(state, depth, ply, alpha, beta, threadData);
+	}
+	return SearchWithWindow<Color::Black>(state, depth, ply, alpha, beta, threadData);
+}
+
+/**
+ * Searches all the root moves with the window (alpha, beta), the first one with the full window and the rest with
+ * null-window scouts. The score is fail-soft: it is an upper bound if it is not greater than alpha, and a lower bound
+ * if it is not less than beta. If the search gets stopped, the result is the best move among the moves that were
+ * completely searched (kNoMove if none).
+ *
+ * The excluded moves (the best lines already found by a MultiPV iteration) are skipped, and the result is then not
+ * stored in the transposition table. If all the moves are excluded, the result is kNoMove.
+ */
+[[nodiscard]] inline std::pair<int, Move> SearchRoot(
+	const State& state,
 	int depth,
-	const std::atomic_flag& stop) {
+	int alpha,
+	const int beta,
+	ThreadData& threadData,
+	const MoveList& excludedMoves = MoveList()) {
 	assert(depth > 0);
-	if (depth <= 4) {
-		return SearchMove(state, depth, stop);
+	++threadData.nodes;
+	const auto key = zobrist::Hash(state);
+	auto* transpositionTable = threadData.transpositionTable;
+	const auto ttEntryOpt = transpositionTable != nullptr ? transpositionTable->Probe(key) : std::nullopt;
+	const auto moves = detail::GenerateOrderedMoves(state, ttEntryOpt.has_value() ? ttEntryOpt->move : std::nullopt);
+	const int originalAlpha = alpha;
+	auto result = std::pair<int, Move>(-kInfinity, kNoMove);
+	if (moves.IsEmpty()) {
+		result.first = detail::IsActiveColorInCheck(state) ? MatedIn(0) : kDraw;
+		return result;
 	}
-
-	auto taskQueue = concurrency::TaskQueue(static_cast<int>(std::thread::hardware_concurrency()));
-	auto futures = std::vector<std::future<std::pair<int, chss::Move>>>();
-	for (const auto move : chss::move_generation::LegalMoves(state)) {
-		if (stop.test()) {
+	threadData.stack[0].Reset();
+	threadData.stack[0].key = key;
+	const auto scoutAndReSearch = state.activeColor == Color::White ? &detail::ScoutAndReSearch<Color::Black>
+																	: &detail::ScoutAndReSearch<Color::White>;
+	std::size_t searchedMoves = 0;
+	for (const auto& move : moves) {
+		if (std::find(excludedMoves.begin(), excludedMoves.end(), move) != excludedMoves.end()) {
+			continue;
+		}
+		if (threadData.reporter != nullptr) {
+			threadData.reporter->ReportCurrentMove(CurrentMoveReport{
+				.depth = depth,
+				.move = move,
+				.moveNumber = static_cast<int>(searchedMoves) + 1});
+		}
+		const auto newState = move_generation::MakeMove(state, move);
+		threadData.stack[0].pieceToSquare = detail::GetPieceToSquare(state, move);
+		threadData.stack[1].Reset();
+		threadData.stack[1].isCutNode = searchedMoves > 0;
+		const auto score = searchedMoves == 0 ? -Search(newState, depth - 1, 1, -beta, -alpha, threadData)
+								  : scoutAndReSearch(newState, depth - 1, 1, 0, alpha, beta, threadData);
+		if (threadData.IsStopped()) {
 			break;
 		}
-		const auto newState = chss::move_generation::MakeMove(state, move);
-		auto future = taskQueue.PushBack(std::function<std::pair<int, chss::Move>()>([newState, depth, &stop, move]() {
-			return std::pair<int, chss::Move>(Search(newState, depth-1, stop), move);
-		}));
-		futures.push_back(std::move(future));
-	}
-	auto resultScore =
-	state.activeColor == chss::Color::White ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
-	auto resultMove = chss::Move{.from = chss::Position{.y = -1, .x = -1}, .to = chss::Position{.y = -1, .x = -1}};
-	for (auto& future : futures) {
-		const auto [score, move] = future.get();
-		if (state.activeColor == chss::Color::White) {
-			if (score > resultScore) {
-				resultScore = score;
-				resultMove = move;
+		++searchedMoves;
+		if (score > result.first || result.second == kNoMove) {
+			result = std::pair<int, Move>(score, move);
+			detail::UpdatePrincipalVariation(threadData.stack, 0, move);
+			alpha = std::max(alpha, score);
+			if (alpha >= beta) {
+				break;
 			}
-		} else {
-			if (score < resultScore) {
-				resultScore = score;
-				resultMove = move;
+		}
+	}
+	if (transpositionTable != nullptr && result.second != kNoMove && !threadData.IsStopped() &&
+		excludedMoves.IsEmpty()) {
+		const auto bound =
+			result.first >= beta ? Bound::Lower : (result.first > originalAlpha ? Bound::Exact : Bound::Upper);
+		transpositionTable->Store(
+			key,
+			TranspositionTableEntry{.depth = depth, .score = result.first, .bound = bound, .move = result.second});
+	}
+	return result;
+}
+
+[[nodiscard]] inline std::pair<int, Move> SearchRoot(const State& state, int depth, ThreadData& threadData) {
+	return SearchRoot(state, depth, -kInfinity, kInfinity, threadData);
+}
+
+// Iterations from this depth on start with an aspiration window of kAspirationWindow around the previous score.
+constexpr int kAspirationMinDepth = 3;
+constexpr int kAspirationWindow = 50;
+
+/**
+ * Searches the position with increasing depths, until maxDepth or until it gets stopped.
+ * Each iteration tries the best move of the previous one first (through the transposition table), and searches with an
+ * aspiration window around the previous score. When the score falls outside of the window, the iteration is repeated
+ * with that side of the window twice as far.
+ *
+ * With SearchOptions::multiPv, each iteration finds that many best moves, one after the other: every line is a root
+ * search that excludes the moves of the lines before it, with an aspiration window around the score of the same line in
+ * the previous iteration. All of them share the transposition table and the histories. The lines of the last iteration
+ * are left in ThreadData::rootLines, best first, with their principal variations, and the result is the first one.
+ *
+ * The lines, as they get searched, and the root moves, as the search starts them, go to ThreadData::reporter.
+ */
+[[nodiscard]] inline std::pair<int, Move> IterativeDeepening(
+	const State& state,
+	const int maxDepth,
+	ThreadData& threadData) {
+	assert(maxDepth > 0);
+	auto& rootLines = threadData.rootLines;
+	auto& lines = threadData.iterationLines;
+	rootLines.clear();
+	const auto multiPv = static_cast<std::size_t>(std::max(threadData.options.multiPv, 1));
+	rootLines.reserve(multiPv);
+	lines.reserve(multiPv);
+	for (int depth = 1; depth <= maxDepth; ++depth) {
+		if (detail::IsDepthSkipped(threadData.id, depth)) {
+			continue;
+		}
+		lines.clear();
+		auto excludedMoves = MoveList();
+		threadData.selDepth = 0;
+		while (lines.size() < multiPv) {
+			const auto pvIndex = lines.size();
+			int delta = kAspirationWindow;
+			int alpha = -kInfinity;
+			int beta = kInfinity;
+			if (threadData.options.useAspirationWindows && depth >= kAspirationMinDepth && pvIndex < rootLines.size() &&
+				!IsMateScore(rootLines[pvIndex].score)) {
+				alpha = std::max(rootLines[pvIndex].score - delta, -kInfinity);
+				beta = std::min(rootLines[pvIndex].score + delta, kInfinity);
+			}
+			auto line = RootLine{.score = -kInfinity, .move = kNoMove};
+			while (true) {
+				const auto iterationResult = SearchRoot(state, depth, alpha, beta, threadData, excludedMoves);
+				const auto& principalVariation = threadData.stack[0].principalVariation;
+				if (threadData.IsStopped()) {
+					// A partial iteration is only trusted if a move was proven to be better than the lower bound of the
+					// window.
+					if (iterationResult.second != kNoMove && (iterationResult.first > alpha || alpha == -kInfinity)) {
+						line = RootLine{
+							.score = iterationResult.first,
+							.move = iterationResult.second,
+							.principalVariation = principalVariation};
+					}
+					break;
+				}
+				delta *= 2;
+				const auto isFailLow = iterationResult.first <= alpha && alpha > -kInfinity;
+				const auto isFailHigh = !isFailLow && iterationResult.first >= beta && beta < kInfinity;
+				if ((isFailLow || isFailHigh) && threadData.reporter != nullptr && iterationResult.second != kNoMove) {
+					threadData.reporter->ReportIteration(IterationReport{
+						.depth = depth,
+						.selDepth = threadData.selDepth,
+						.multiPv = static_cast<int>(pvIndex) + 1,
+						.score = iterationResult.first,
+						.bound = isFailLow ? Bound::Upper : Bound::Lower,
+						.principalVariation = principalVariation});
+				}
+				if (isFailLow) {
+					++threadData.stats.aspirationFailLows;
+					alpha = std::max(alpha - delta, -kInfinity);
+				} else if (isFailHigh) {
+					++threadData.stats.aspirationFailHighs;
+					beta = std::min(beta + delta, kInfinity);
+				} else {
+					line = RootLine{
+						.score = iterationResult.first,
+						.move = iterationResult.second,
+						.principalVariation = principalVariation};
+					break;
+				}
+			}
+			if (line.move == kNoMove) {
+				// Stopped, or there are fewer legal moves than lines (or none at all).
+				if (lines.empty() && !threadData.IsStopped()) {
+					lines.push_back(line);
+				}
+				break;
+			}
+			lines.push_back(line);
+			excludedMoves.PushBack(line.move);
+			if (threadData.IsStopped()) {
+				break;
 			}
 		}
+		// A later line can score higher than an earlier one, when the earlier one failed low after being searched. The
+		// insertion sort keeps the order of equal scores like std::stable_sort, without its temporary buffer.
+		const auto isBetter = [](const RootLine& lhs, const RootLine& rhs) { return lhs.score > rhs.score; };
+		for (auto it = lines.begin(); it != lines.end(); ++it) {
+			std::rotate(std::upper_bound(lines.begin(), it, *it, isBetter), it, std::next(it));
+		}
+		if (!threadData.IsStopped() && threadData.reporter != nullptr) {
+			for (std::size_t i = 0; i < lines.size() && lines[i].move != kNoMove; ++i) {
+				threadData.reporter->ReportIteration(IterationReport{
+					.depth = depth,
+					.selDepth = threadData.selDepth,
+					.multiPv = static_cast<int>(i) + 1,
+					.score = lines[i].score,
+					.bound = Bound::Exact,
+					.principalVariation = lines[i].principalVariation});
+			}
+		}
+		if (threadData.IsStopped()) {
+			// The lines of the previous iteration complete the ones that this one could search.
+			for (const auto& previousLine : rootLines) {
+				const auto isInLines = std::any_of(
+					lines.begin(),
+					lines.end(),
+					[&previousLine](const auto& line) { return line.move == previousLine.move; });
+				if (lines.size() < multiPv && !isInLines) {
+					lines.push_back(previousLine);
+				}
+			}
+		}
+		std::swap(rootLines, lines);
+		if (threadData.IsStopped()) {
+			break;
+		}
 	}
-	return std::pair<int, chss::Move>(resultScore, resultMove);
+	return rootLines.empty() ? std::pair<int, Move>(-kInfinity, kNoMove)
+							 : std::pair<int, Move>(rootLines.front().score, rootLines.front().move);
+}
+
+/**
+ * The principal variation that starts with the given moves (at least one, legal, such as the principal variation of a
+ * RootLine, which transposition table cutoffs can cut short), continued as far as the transposition table remembers
+ * it: it follows the table moves while they are legal, and stops before the first position that repeats.
+ */
+[[nodiscard]] inline std::vector<Move> PrincipalVariation(
+	const State& state,
+	const std::span<const Move> firstMoves,
+	const TranspositionTable& transpositionTable) {
+	assert(!firstMoves.empty());
+	auto principalVariation = std::vector<Move>(firstMoves.begin(), firstMoves.end());
+	auto keys = std::vector<std::uint64_t>();
+	auto currentState = state;
+	for (const auto& move : firstMoves) {
+		keys.push_back(zobrist::Hash(currentState));
+		currentState = move_generation::MakeMove(currentState, move);
+	}
+	while (principalVariation.size() < kMaxPly) {
+		const auto key = zobrist::Hash(currentState);
+		if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+			break;
+		}
+		const auto entryOpt = transpositionTable.Probe(key);
+		if (!entryOpt.has_value() || !entryOpt->move.has_value()) {
+			break;
+		}
+		const auto move = entryOpt->move.value();
+		if (!move_generation::IsLegal(currentState, move)) {
+			break;
+		}
+		principalVariation.push_back(move);
+		keys.push_back(key);
+		currentState = move_generation::MakeMove(currentState, move);
+	}
+	return principalVariation;
+}
+
+[[nodiscard]] inline std::vector<Move> PrincipalVariation(
+	const State& state,
+	const Move& firstMove,
+	const TranspositionTable& transpositionTable) {
+	return PrincipalVariation(state, std::span<const Move>(&firstMove, 1), transpositionTable);
+}
+
+/**
+ * Single-threaded search with its own (small) transposition table.
+ */
+[[nodiscard]] inline std::pair<int, Move> SearchMove(const State& state, int depth, std::atomic_flag& stop) {
+	auto transpositionTable = TranspositionTable(1);
+	auto threadData = ThreadData{.id = 0, .transpositionTable = &transpositionTable, .stop = &stop, .nodes = 0};
+	return IterativeDeepening(state, depth, threadData);
 }
 
 } // namespace chss::search
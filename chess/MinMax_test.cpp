@@ -1,28 +1,449 @@
 #include "MinMax.h"
 
 #include "fen/Fen.h"
+#include "move_generation/MakeMove.h"
 #include "representation/Move.h"
+#include "search/Zobrist.h"
 
 #include <test_utils/TestUtils.h>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+// The state of one search thread, without a transposition table.
+chss::search::ThreadData MakeThreadData(std::atomic_flag& stop, const chss::search::SearchOptions& options = {}) {
+	return chss::search::ThreadData{
+		.id = 0,
+		.transpositionTable = nullptr,
+		.stop = &stop,
+		.nodes = 0,
+		.options = options};
+}
+
+struct SearchOutcome {
+	std::pair<int, chss::Move> result;
+	std::int64_t nodes;
+	chss::search::SearchStats stats;
+};
+
+// An iterative deepening with the options, and a transposition table of its own.
+SearchOutcome SearchWithOptions(const chss::State& state, int depth, const chss::search::SearchOptions& options) {
+	auto stop = std::atomic_flag(false);
+	auto transpositionTable = chss::search::TranspositionTable(1);
+	auto threadData = MakeThreadData(stop, options);
+	threadData.transpositionTable = &transpositionTable;
+	const auto result = chss::search::IterativeDeepening(state, depth, threadData);
+	return SearchOutcome{.result = result, .nodes = threadData.nodes, .stats = threadData.stats};
+}
+
+} // namespace
+
 TEST(Search, MateInOne) {
 	auto stop = std::atomic_flag(false);
 	EXPECT_EQ(
 		chss::search::SearchMove(chss::fen::Parse("2k5/7R/2K5/8/8/8/8/8 w - - 0 1"), 2, stop),
-		(std::pair<int, chss::Move>(2147483647, chss::Move{.from = chss::positions::H7, .to = chss::positions::H8})));
+		(std::pair<int, chss::Move>(
+			chss::search::MateIn(1),
+			chss::Move{.from = chss::positions::H7, .to = chss::positions::H8})));
 	EXPECT_EQ(
 		chss::search::SearchMove(chss::fen::Parse("8/8/8/7q/8/2k5/8/2K5 b - - 0 1"), 2, stop),
-		(std::pair<int, chss::Move>(-2147483648, chss::Move{.from = chss::positions::H5, .to = chss::positions::H1})));
+		(std::pair<int, chss::Move>(
+			chss::search::MateIn(1),
+			chss::Move{.from = chss::positions::H5, .to = chss::positions::H1})));
 }
 
 TEST(Search, MateInTwo) {
 	auto stop = std::atomic_flag(false);
 	EXPECT_EQ(
 		chss::search::SearchMove(chss::fen::Parse("7K/8/8/8/6R1/7R/1k6/8 w - - 0 1"), 4, stop),
-		(std::pair<int, chss::Move>(2147483647, chss::Move{.from = chss::positions::G4, .to = chss::positions::G2})));
+		(std::pair<int, chss::Move>(
+			chss::search::MateIn(3),
+			chss::Move{.from = chss::positions::G4, .to = chss::positions::G2})));
 	EXPECT_EQ(
 		chss::search::SearchMove(chss::fen::Parse("4K2b/8/4pk2/8/7N/6Q1/8/8 w - - 0 1"), 4, stop),
-		(std::pair<int, chss::Move>(2147483647, chss::Move{.from = chss::positions::E8, .to = chss::positions::F8})));
+		(std::pair<int, chss::Move>(
+			chss::search::MateIn(3),
+			chss::Move{.from = chss::positions::E8, .to = chss::positions::F8})));
+}
+
+TEST(Search, AlphaBetaMatchesMinimax) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	int expectedScore = -chss::search::kInfinity;
+	for (const auto move : chss::move_generation::LegalMoves(state)) {
+		const auto newState = chss::move_generation::MakeMove(state, move);
+		int childScore = chss::search::kInfinity;
+		for (const auto childMove : chss::move_generation::LegalMoves(newState)) {
+			const auto evaluation =
+				chss::evaluation::Evaluate(chss::move_generation::MakeMove(newState, childMove).board);
+			childScore = std::min(childScore, evaluation);
+		}
+		expectedScore = std::max(expectedScore, childScore);
+	}
+	EXPECT_EQ(chss::search::SearchRoot(state, 2, threadData).first, expectedScore);
+}
+
+TEST(Search, NullWindowBoundsTheScore) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	const auto exactScore = chss::search::SearchRoot(state, 2, threadData).first;
+	EXPECT_LE(chss::search::SearchRoot(state, 2, exactScore, exactScore + 1, threadData).first, exactScore);
+	EXPECT_GE(chss::search::SearchRoot(state, 2, exactScore - 1, exactScore, threadData).first, exactScore);
+}
+
+TEST(Search, AspirationWindowsDoNotChangeTheResult) {
+	const auto state = chss::fen::Parse("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1");
+	const auto withoutWindows = SearchWithOptions(
+		state,
+		5,
+		{.useAspirationWindows = false, .useNullMovePruning = false, .useLateMoveReductions = false});
+	const auto withWindows = SearchWithOptions(state, 5, {.useNullMovePruning = false, .useLateMoveReductions = false});
+	EXPECT_EQ(withWindows.result, withoutWindows.result);
+	EXPECT_EQ(withoutWindows.stats.aspirationFailHighs + withoutWindows.stats.aspirationFailLows, 0);
+}
+
+TEST(Search, NullMovePruningAndLateMoveReductionsSaveNodes) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	const auto withoutPruning =
+		SearchWithOptions(state, 4, {.useNullMovePruning = false, .useLateMoveReductions = false});
+	const auto withPruning = SearchWithOptions(state, 4, {});
+	EXPECT_GT(withPruning.stats.nullMoveCutoffs, 0);
+	EXPECT_GT(withPruning.stats.lateMoveReductions, 0);
+	EXPECT_LT(withPruning.nodes, withoutPruning.nodes);
+}
+
+TEST(Search, NoNullMoveInPawnEndings) {
+	const auto state = chss::fen::Parse("8/8/1p1k4/1P6/2P5/3K4/8/8 w - - 0 1");
+	EXPECT_EQ(SearchWithOptions(state, 5, {}).stats.nullMoveTries, 0);
+}
+
+TEST(Search, QuiescenceResolvesCaptures) {
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	// The black queen on d5 is not defended.
+	const auto hangingQueen = chss::fen::Parse("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1");
+	const auto staticEvaluation = chss::evaluation::Evaluate(hangingQueen.board);
+	EXPECT_GT(
+		chss::search::Quiescence(hangingQueen, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		staticEvaluation + 800);
+	// Quiet positions are just evaluated.
+	const auto quiet = chss::fen::Parse("4k3/8/8/8/8/8/8/3RK3 w - - 0 1");
+	EXPECT_EQ(
+		chss::search::Quiescence(quiet, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		chss::evaluation::Evaluate(quiet.board));
+}
+
+TEST(Search, FrontierPruningSavesNodes) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	const auto withoutPruning = SearchWithOptions(state, 5, {.useFrontierPruning = false});
+	const auto withPruning = SearchWithOptions(state, 5, {});
+	const auto& stats = withPruning.stats;
+	EXPECT_GT(stats.reverseFutilityPrunes + stats.razoringPrunes + stats.futilityPrunes + stats.lateMovePrunes, 0);
+	EXPECT_LT(withPruning.nodes, withoutPruning.nodes);
+}
+
+TEST(Search, CheckExtensionFindsMateSooner) {
+	// Qg8+ Rxg8 Nf7#: the mate is seen at depth 3 because Nf7+ gets extended. (Razoring would prune Nf7, a quiet move
+	// after a queen sacrifice.)
+	const auto state = chss::fen::Parse("5r1k/6pp/7N/8/2Q5/8/8/6K1 w - - 0 1");
+	const auto withExtensions = SearchWithOptions(state, 3, {.useFrontierPruning = false});
+	EXPECT_EQ(
+		withExtensions.result,
+		(std::pair<int, chss::Move>(
+			chss::search::MateIn(3),
+			chss::Move{.from = chss::positions::C4, .to = chss::positions::G8, .promotionType = std::nullopt})));
+	EXPECT_GT(withExtensions.stats.checkExtensions, 0);
+	const auto withoutExtensions = SearchWithOptions(state, 3, {.useFrontierPruning = false, .useExtensions = false});
+	EXPECT_FALSE(chss::search::IsMateScore(withoutExtensions.result.first));
+}
+
+TEST(Search, ExcludedMoveIsNotSearched) {
+	// The only legal move is Kg1.
+	const auto state = chss::fen::Parse("8/8/8/8/8/6k1/7r/7K w - - 0 1");
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	const auto onlyMove =
+		chss::Move{.from = chss::positions::H1, .to = chss::positions::G1, .promotionType = std::nullopt};
+	EXPECT_GT(
+		chss::search::Search(state, 2, 0, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		-chss::search::kInfinity);
+	threadData.stack[0].excludedMove = onlyMove;
+	EXPECT_EQ(
+		chss::search::Search(state, 2, 0, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		-chss::search::kInfinity);
+}
+
+TEST(Search, ProbCutPrunesWhenACaptureBeatsBeta) {
+	// Beta is far below the evaluation: any safe capture proves the fail high. (Null-move pruning would prune the node
+	// first.)
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop, {.useNullMovePruning = false});
+	EXPECT_GE(chss::search::Search(state, 5, 0, -1001, -1000, threadData), -1000);
+	EXPECT_GE(threadData.stats.probCutCutoffs, 1);
+
+	auto verifying = MakeThreadData(stop, {.useNullMovePruning = false, .verifyProbCut = true});
+	EXPECT_GE(chss::search::Search(state, 5, 0, -1001, -1000, verifying), -1000);
+	EXPECT_GT(verifying.nodes, threadData.nodes);
+	EXPECT_GE(verifying.stats.probCutConfirmed, 1);
+	EXPECT_LE(verifying.stats.probCutConfirmed, verifying.stats.probCutCutoffs);
+}
+
+TEST(Search, SortedMovesFollowTheHistoryTables) {
+	// White can win the queen (Nxd5), trade a pawn (exd5), or lose the knight for a pawn (Nxe5).
+	const auto state = chss::fen::Parse("4k3/8/8/3qp3/4P3/2N2N2/8/4K3 w - - 0 1");
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	const auto ttMove =
+		chss::Move{.from = chss::positions::E1, .to = chss::positions::E2, .promotionType = std::nullopt};
+	const auto counterMove =
+		chss::Move{.from = chss::positions::E1, .to = chss::positions::F2, .promotionType = std::nullopt};
+	const auto previous = chss::search::PieceToSquare{
+		.piece = chss::Piece{.type = chss::PieceType::Queen, .color = chss::Color::Black},
+		.to = chss::positions::D5};
+	threadData.stack[0].pieceToSquare = previous;
+	threadData.histories->counterMoves.Set(previous, counterMove);
+	const auto goodQuietMove =
+		chss::Move{.from = chss::positions::F3, .to = chss::positions::H4, .promotionType = std::nullopt};
+	threadData.histories->butterfly.Update(chss::Color::White, goodQuietMove, 1000);
+
+	const auto moves = detail::GenerateSortedMoves<chss::Color::White>(state, ttMove, 1, threadData);
+	ASSERT_GE(moves.GetSize(), std::size_t{7});
+	EXPECT_EQ(moves[0], ttMove);
+	EXPECT_EQ(
+		moves[1],
+		(chss::Move{.from = chss::positions::C3, .to = chss::positions::D5, .promotionType = std::nullopt}));
+	EXPECT_EQ(
+		moves[2],
+		(chss::Move{.from = chss::positions::E4, .to = chss::positions::D5, .promotionType = std::nullopt}));
+	EXPECT_EQ(moves[3], counterMove);
+	EXPECT_EQ(moves[4], goodQuietMove);
+	EXPECT_EQ(
+		moves[moves.GetSize() - 1],
+		(chss::Move{.from = chss::positions::F3, .to = chss::positions::E5, .promotionType = std::nullopt}));
+}
+
+TEST(Search, CutoffsFillTheHistoryTables) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	std::ignore = chss::search::SearchRoot(state, 5, threadData);
+	// After 1. Qxf6, taking the queen back refutes it.
+	auto queenRecaptureHistory = 0;
+	for (const auto type : {chss::PieceType::Pawn, chss::PieceType::Bishop, chss::PieceType::Queen}) {
+		queenRecaptureHistory += threadData.histories->capture.Get(
+			chss::search::PieceToSquare{
+				.piece = chss::Piece{.type = type, .color = chss::Color::Black},
+				.to = chss::positions::F6},
+			chss::PieceType::Queen);
+	}
+	EXPECT_GT(queenRecaptureHistory, 0);
+	// Some quiet moves of Black refuted some first moves of White.
+	auto hasCounterMove = false;
+	for (const auto& move : chss::move_generation::LegalMoves(state)) {
+		hasCounterMove |= threadData.histories->counterMoves.Get(detail::GetPieceToSquare(state, move)).has_value();
+	}
+	EXPECT_TRUE(hasCounterMove);
+}
+
+TEST(Search, NodesWithoutTtMoveAreReducedOrDeepened) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto stop = std::atomic_flag(false);
+	const auto search = [&](const chss::search::InternalIteration internalIteration) {
+		auto transpositionTable = chss::search::TranspositionTable(1);
+		auto threadData = MakeThreadData(stop, {.internalIteration = internalIteration});
+		threadData.transpositionTable = &transpositionTable;
+		// A single iteration: the table has no moves to offer yet.
+		std::ignore = chss::search::SearchRoot(state, 5, threadData);
+		return threadData.stats;
+	};
+	const auto none = search(chss::search::InternalIteration::None);
+	EXPECT_EQ(none.internalIterativeReductions, 0);
+	EXPECT_EQ(none.internalIterativeDeepenings, 0);
+	const auto reductions = search(chss::search::InternalIteration::Reductions);
+	EXPECT_GT(reductions.internalIterativeReductions, 0);
+	EXPECT_EQ(reductions.internalIterativeDeepenings, 0);
+	const auto deepening = search(chss::search::InternalIteration::Deepening);
+	EXPECT_EQ(deepening.internalIterativeReductions, 0);
+	EXPECT_GT(deepening.internalIterativeDeepenings, 0);
+}
+
+TEST(Search, RepetitionOfAGamePositionIsADraw) {
+	// 1. Nf3 Nf6 2. Ng1 Ng8: the knights went back, and 3. Nf3 would repeat the position after 1. Nf3.
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	auto state = chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	for (const auto move :
+		 {chss::Move{.from = chss::positions::G1, .to = chss::positions::F3, .promotionType = std::nullopt},
+		  chss::Move{.from = chss::positions::G8, .to = chss::positions::F6, .promotionType = std::nullopt},
+		  chss::Move{.from = chss::positions::F3, .to = chss::positions::G1, .promotionType = std::nullopt},
+		  chss::Move{.from = chss::positions::F6, .to = chss::positions::G8, .promotionType = std::nullopt}}) {
+		threadData.gameKeys.push_back(chss::search::zobrist::Hash(state));
+		state = chss::move_generation::MakeMove(state, move);
+	}
+	EXPECT_EQ(state.halfmoveClock, 4);
+	threadData.stack[0].key = chss::search::zobrist::Hash(state);
+	const auto nf3 =
+		chss::move_generation::MakeMove(
+			state,
+			chss::Move{.from = chss::positions::G1, .to = chss::positions::F3, .promotionType = std::nullopt});
+	EXPECT_EQ(
+		chss::search::Search(nf3, 3, 1, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		chss::search::kDraw);
+	EXPECT_EQ(threadData.nodes, 1);
+
+	// After a pawn move, nothing before it can repeat.
+	const auto e4 =
+		chss::move_generation::MakeMove(
+			state,
+			chss::Move{.from = chss::positions::E2, .to = chss::positions::E4, .promotionType = std::nullopt});
+	EXPECT_FALSE(detail::IsRepetition(threadData.gameKeys[0], e4.halfmoveClock, 1, threadData));
+}
+
+TEST(Search, FiftyMoveRuleIsADrawUnlessItIsCheckmate) {
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	// White is a queen up, but fifty moves went by without captures or pawn moves.
+	const auto drawn = chss::fen::Parse("4k3/8/8/8/8/8/8/3QK3 w - - 100 80");
+	EXPECT_EQ(
+		chss::search::Search(drawn, 3, 1, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		chss::search::kDraw);
+	const auto notYet = chss::fen::Parse("4k3/8/8/8/8/8/8/3QK3 w - - 90 80");
+	EXPECT_GT(
+		chss::search::Search(notYet, 3, 1, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		chss::search::kDraw);
+	// The move that completed the fifty moves was checkmate.
+	EXPECT_FALSE(detail::IsFiftyMoveDraw(chss::fen::Parse("7k/6Q1/6K1/8/8/8/8/8 b - - 100 80")));
+}
+
+TEST_CASE("Search", "MateScores") {
+	STATIC_REQUIRE(chss::search::MateIn(1) > chss::search::MateIn(3));
+	STATIC_REQUIRE(chss::search::MatedIn(2) < chss::search::MatedIn(4));
+	STATIC_REQUIRE(chss::search::IsMateScore(chss::search::MateIn(chss::search::kMaxPly)));
+	STATIC_REQUIRE(!chss::search::IsMateScore(chss::evaluation::PieceValue(chss::PieceType::Queen) * 9));
+	STATIC_REQUIRE(chss::search::MateInMoves(chss::search::MateIn(1)) == 1);
+	STATIC_REQUIRE(chss::search::MateInMoves(chss::search::MateIn(3)) == 2);
+	STATIC_REQUIRE(chss::search::MateInMoves(chss::search::MatedIn(2)) == -1);
+	STATIC_REQUIRE(chss::search::MateInMoves(chss::search::MatedIn(4)) == -2);
+}
+
+TEST_CASE("Search", "MateScoresInTheTranspositionTableAreRelativeToTheNode") {
+	// A mate 2 plies after a node at ply 3 is a mate 2 plies after the same node at ply 1.
+	STATIC_REQUIRE(
+		detail::ScoreFromTranspositionTable(detail::ScoreToTranspositionTable(chss::search::MateIn(5), 3), 1) ==
+		chss::search::MateIn(3));
+	STATIC_REQUIRE(
+		detail::ScoreFromTranspositionTable(detail::ScoreToTranspositionTable(chss::search::MatedIn(6), 4), 2) ==
+		chss::search::MatedIn(4));
+	STATIC_REQUIRE(detail::ScoreFromTranspositionTable(detail::ScoreToTranspositionTable(150, 3), 1) == 150);
+}
+
+TEST(Search, CheckmateAndStalemate) {
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop);
+	const auto checkmate = chss::fen::Parse("7k/6Q1/6K1/8/8/8/8/8 b - - 0 1");
+	EXPECT_EQ(
+		chss::search::Search(checkmate, 2, 1, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		chss::search::MatedIn(1));
+	const auto stalemate = chss::fen::Parse("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1");
+	EXPECT_EQ(
+		chss::search::Search(stalemate, 2, 1, -chss::search::kInfinity, chss::search::kInfinity, threadData),
+		chss::search::kDraw);
+	EXPECT_EQ(
+		chss::search::SearchRoot(stalemate, 2, threadData),
+		(std::pair<int, chss::Move>(chss::search::kDraw, chss::search::kNoMove)));
+}
+
+TEST(Search, ShortestMateIsPreferred) {
+	// Rh8# mates at once; other moves (like Rh7) mate later.
+	auto stop = std::atomic_flag(false);
+	EXPECT_EQ(
+		chss::search::SearchMove(chss::fen::Parse("k7/8/1K6/8/8/8/8/7R w - - 0 1"), 4, stop),
+		(std::pair<int, chss::Move>(
+			chss::search::MateIn(1),
+			chss::Move{.from = chss::positions::H1, .to = chss::positions::H8, .promotionType = std::nullopt})));
+}
+
+TEST(Search, MateDistancePruningSavesNodes) {
+	// A mate in one: the deeper lines cannot find a shorter mate.
+	const auto state = chss::fen::Parse("k7/8/1K6/8/8/8/8/7R w - - 0 1");
+	const auto withPruning = SearchWithOptions(state, 5, {});
+	const auto withoutPruning = SearchWithOptions(state, 5, {.useMateDistancePruning = false});
+	EXPECT_EQ(withPruning.result.first, chss::search::MateIn(1));
+	EXPECT_EQ(withoutPruning.result.first, chss::search::MateIn(1));
+	EXPECT_LT(withPruning.nodes, withoutPruning.nodes);
+}
+
+TEST(Search, MultiPvFindsTheBestLinesInOrder) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto expectedScores = std::vector<std::pair<int, chss::Move>>();
+	for (const auto move : chss::move_generation::LegalMoves(state)) {
+		const auto newState = chss::move_generation::MakeMove(state, move);
+		int childScore = chss::search::kInfinity;
+		for (const auto childMove : chss::move_generation::LegalMoves(newState)) {
+			const auto evaluation =
+				chss::evaluation::Evaluate(chss::move_generation::MakeMove(newState, childMove).board);
+			childScore = std::min(childScore, evaluation);
+		}
+		expectedScores.emplace_back(childScore, move);
+	}
+	std::stable_sort(expectedScores.begin(), expectedScores.end(), [](const auto& lhs, const auto& rhs) {
+		return lhs.first > rhs.first;
+	});
+
+	auto stop = std::atomic_flag(false);
+	auto threadData = MakeThreadData(stop, {.multiPv = 4});
+	const auto result = chss::search::IterativeDeepening(state, 2, threadData);
+	ASSERT_EQ(threadData.rootLines.size(), std::size_t{4});
+	EXPECT_EQ(threadData.rootLines.front().score, result.first);
+	EXPECT_EQ(threadData.rootLines.front().move, result.second);
+	for (std::size_t i = 0; i < threadData.rootLines.size(); ++i) {
+		EXPECT_EQ(threadData.rootLines[i].score, expectedScores[i].first);
+		for (std::size_t j = 0; j < i; ++j) {
+			EXPECT_NE(threadData.rootLines[i].move, threadData.rootLines[j].move);
+		}
+	}
+}
+
+TEST(Search, PrincipalVariationIsALegalLine) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto stop = std::atomic_flag(false);
+	// Without a transposition table, no cutoff cuts the line short.
+	auto threadData = MakeThreadData(stop);
+	const auto [score, move] = chss::search::IterativeDeepening(state, 4, threadData);
+	ASSERT_EQ(threadData.rootLines.size(), std::size_t{1});
+	const auto& principalVariation = threadData.rootLines.front().principalVariation;
+	ASSERT_GE(principalVariation.GetSize(), std::size_t{4});
+	EXPECT_EQ(principalVariation[0], move);
+	auto currentState = state;
+	for (const auto& pvMove : principalVariation) {
+		auto isLegal = false;
+		for (const auto legalMove : chss::move_generation::LegalMoves(currentState)) {
+			isLegal = isLegal || legalMove == pvMove;
+		}
+		ASSERT_TRUE(isLegal);
+		currentState = chss::move_generation::MakeMove(currentState, pvMove);
+	}
+}
+
+TEST(Search, MultiPvWithMoreLinesThanMoves) {
+	auto stop = std::atomic_flag(false);
+	auto transpositionTable = chss::search::TranspositionTable(1);
+	auto threadData = MakeThreadData(stop, {.multiPv = 5});
+	threadData.transpositionTable = &transpositionTable;
+	std::ignore = chss::search::IterativeDeepening(chss::fen::Parse("k7/8/8/8/8/8/8/K7 w - - 0 1"), 4, threadData);
+	EXPECT_EQ(threadData.rootLines.size(), std::size_t{3});
+
+	const auto [score, move] =
+		chss::search::IterativeDeepening(chss::fen::Parse("k6R/8/1K6/8/8/8/8/8 b - - 0 1"), 4, threadData);
+	EXPECT_EQ(score, chss::search::MatedIn(0));
+	EXPECT_EQ(move, chss::search::kNoMove);
+	EXPECT_EQ(threadData.rootLines.size(), std::size_t{1});
 }
@@ -10,7 +10,10 @@ namespace chss::move_generation {
 
 [[nodiscard]] constexpr std::int64_t Perft(const State& state, int depth, std::atomic_flag& stop);
 
-}
+template<Color kColor>
+[[nodiscard]] constexpr std::int64_t Perft(const State& state, int depth, std::atomic_flag& stop);
+
+} // namespace chss::move_generation
 
 namespace detail {
 
@@ -40,24 +43,33 @@ inline void CreatePerfTasks(
 
 namespace chss::move_generation {
 
+// Perft of a position whose active color is kColor.
+template<Color kColor>
 [[nodiscard]] constexpr std::int64_t Perft(const State& state, int depth, std::atomic_flag& stop) {
 	if (depth == 0) {
 		return 1;
 	}
 	std::int64_t nodesVisited = 0;
-	for (const auto move : LegalMoves(state)) {
+	for (const auto move : LegalMoves<kColor>(state)) {
 		if !consteval {
 			if (stop.test()) {
 				break;
 			}
 		}
-		const auto newState = MakeMove(state, move);
-		const std::int64_t newNodesVisited = Perft(newState, depth - 1, stop);
+		const auto newState = MakeMove<kColor>(state, move);
+		const std::int64_t newNodesVisited = Perft<InverseColor(kColor)>(newState, depth - 1, stop);
 		nodesVisited += newNodesVisited;
 	}
 	return nodesVisited;
 }
 
+[[nodiscard]] constexpr std::int64_t Perft(const State& state, int depth, std::atomic_flag& stop) {
+	if (state.activeColor == Color::White) {
+		return Perft<Color::White>(state, depth, stop);
+	}
+	return Perft<Color::Black>(state, depth, stop);
+}
+
 [[nodiscard]] inline std::int64_t ParallelPerft(const State& state, int depth, std::atomic_flag& stop) {
 	auto taskQueue = concurrency::TaskQueue(static_cast<int>(std::thread::hardware_concurrency()));
 	auto futures = std::vector<std::future<std::int64_t>>();
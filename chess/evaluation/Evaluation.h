@@ -2,24 +2,45 @@
 
 #include "chess/representation/Board.h"
 
+#include <array>
+#include <cstddef>
+
 namespace chss::evaluation {
 
-[[nodiscard]] constexpr int Evaluate(const Board& board) {
-	// clang-format off
-	constexpr auto kCentralityValues = matrix::Matrix2D<int, matrix::Size2D{.sizeX = 8, .sizeY = 8}>(
-		std::array<int, 64>{
-			1, 1, 1, 1, 1, 1, 1, 1,
-			1, 2, 2, 2, 2, 2, 2, 1,
-			1, 2, 3, 3, 3, 3, 2, 1,
-			1, 2, 3, 4, 4, 3, 2, 1,
-			1, 2, 3, 4, 4, 3, 2, 1,
-			1, 2, 3, 3, 3, 3, 2, 1,
-			1, 2, 2, 2, 2, 2, 2, 1,
-			1, 1, 1, 1, 1, 1, 1, 1,
+constexpr auto kPieceValues = std::array<int, 6>{100, 300, 300, 500, 900, 20000};
+
+[[nodiscard]] constexpr int PieceValue(const PieceType type) {
+	return kPieceValues[static_cast<std::underlying_type_t<PieceType>>(type)];
+}
+
+/**
+ * The centrality value of a square is the number of these sets that it is in: the whole board, then each set without
+ * its border, down to the 4 central squares.
+ */
+constexpr auto kCentralitySets = [] {
+	auto sets = std::array<SquareSet, 4>{SquareSet::Full(), SquareSet(), SquareSet(), SquareSet()};
+	for (std::size_t i = 1; i < sets.size(); ++i) {
+		const auto& outer = sets[i - 1];
+		sets[i] = outer & outer.Shift(matrix::Direction2D{.deltaY = -1, .deltaX = 0}) &
+			outer.Shift(matrix::Direction2D{.deltaY = +1, .deltaX = 0}) &
+			outer.Shift(matrix::Direction2D{.deltaY = 0, .deltaX = -1}) &
+			outer.Shift(matrix::Direction2D{.deltaY = 0, .deltaX = +1});
+	}
+	return sets;
+}();
+
+// The number of kCentralitySets that each square is in.
+constexpr auto kCentralityValues = [] {
+	auto values = matrix::Matrix2D<int, matrix::Size2D{.sizeY = 8, .sizeX = 8}>(0);
+	for (const auto& centralitySet : kCentralitySets) {
+		for (const auto position : ForEach(values.GetSize())) {
+			values.At(position) += centralitySet.At(position) ? 1 : 0;
 		}
-	);
-	// clang-format on
-	constexpr auto kPieceValues = std::array<int, 6>{100, 300, 300, 500, 900, 20000};
+	}
+	return values;
+}();
+
+[[nodiscard]] constexpr int Evaluate(const Board& board) {
 	int result = 0;
 	for (const auto position : ForEach(board.GetSize())) {
 		const auto pieceOpt = board.At(position);
@@ -27,8 +48,7 @@ namespace chss::evaluation {
 			continue;
 		}
 		const auto [type, color] = pieceOpt.value();
-		const auto typeIndex = static_cast<std::underlying_type_t<chss::PieceType>>(type);
-		const auto pieceValue = kPieceValues[typeIndex];
+		const auto pieceValue = PieceValue(type);
 		const auto centralityValue = kCentralityValues.At(position);
 		const auto value = color == Color::White ? +(pieceValue + centralityValue) : -(pieceValue + centralityValue);
 		result += value;
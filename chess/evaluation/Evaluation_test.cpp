@@ -18,3 +18,37 @@ TEST_CASE("Evaluation", "EvaluateOnlyBlack") {
 	constexpr auto board = chss::fen::ParseBoard("rnbqkbnr/pppppppp/8/8/8/8/8/8");
 	STATIC_REQUIRE(chss::evaluation::Evaluate(board) == -23922);
 }
+
+TEST_CASE("Evaluation", "CentralitySets_GiveTheCentralityValues") {
+	// clang-format off
+	constexpr auto kCentralityValues = std::array<int, 64>{
+		1, 1, 1, 1, 1, 1, 1, 1,
+		1, 2, 2, 2, 2, 2, 2, 1,
+		1, 2, 3, 3, 3, 3, 2, 1,
+		1, 2, 3, 4, 4, 3, 2, 1,
+		1, 2, 3, 4, 4, 3, 2, 1,
+		1, 2, 3, 3, 3, 3, 2, 1,
+		1, 2, 2, 2, 2, 2, 2, 1,
+		1, 1, 1, 1, 1, 1, 1, 1,
+	};
+	// clang-format on
+	STATIC_REQUIRE(chss::evaluation::kCentralityValues.GetData() == kCentralityValues);
+}
+
+// The evaluation is symmetric: mirroring the board and swapping the colors negates it.
+TEST_CASE("Evaluation", "CentralitySets_AreSymmetric") {
+	constexpr auto areSymmetric = [] {
+		for (const auto& centralitySet : chss::evaluation::kCentralitySets) {
+			if (matrix::FlipVertical(centralitySet) != centralitySet ||
+				matrix::FlipHorizontal(centralitySet) != centralitySet ||
+				matrix::Transpose(centralitySet) != centralitySet) {
+				return false;
+			}
+		}
+		return true;
+	}();
+	STATIC_REQUIRE(areSymmetric);
+	constexpr auto board = chss::fen::ParseBoard("4k3/8/8/3q4/8/1N6/8/4K3");
+	constexpr auto mirroredBoard = chss::fen::ParseBoard("4k3/8/1n6/8/3Q4/8/8/4K3");
+	STATIC_REQUIRE(chss::evaluation::Evaluate(board) == -chss::evaluation::Evaluate(mirroredBoard));
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "chess/evaluation/Evaluation.h"
+#include "chess/move_generation/IsInCheck.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace detail {
+
+[[nodiscard]] constexpr std::optional<chss::Position> FindLeastValuableAttacker(
+	const chss::Board& board,
+	const chss::Position& square,
+	const chss::Color attackerColor) {
+	const auto attackers = chss::move_generation::Attackers(board, square, attackerColor);
+	auto result = std::optional<chss::Position>();
+	int resultValue = 0;
+	for (const auto& position : attackers) {
+		const auto value = chss::evaluation::PieceValue(board.At(position).value().type);
+		if (!result.has_value() || value < resultValue) {
+			result = position;
+			resultValue = value;
+		}
+	}
+	return result;
+}
+
+[[nodiscard]] constexpr bool IsEnPassant(const chss::State& state, const chss::Move& move) {
+	return state.enPassantTargetSquare == move.to && state.board.At(move.from).value().type == chss::PieceType::Pawn;
+}
+
+// Material won by the move itself, before any recapture (captured piece + promotion gain).
+[[nodiscard]] constexpr int MoveGain(const chss::State& state, const chss::Move& move) {
+	int gain = 0;
+	if (const auto& capturedOpt = state.board.At(move.to); capturedOpt.has_value()) {
+		gain += chss::evaluation::PieceValue(capturedOpt.value().type);
+	} else if (IsEnPassant(state, move)) {
+		gain += chss::evaluation::PieceValue(chss::PieceType::Pawn);
+	}
+	if (move.promotionType.has_value()) {
+		gain += chss::evaluation::PieceValue(move.promotionType.value()) -
+			chss::evaluation::PieceValue(chss::PieceType::Pawn);
+	}
+	return gain;
+}
+
+// Board after the move, as seen by the exchange on move.to (castling rights, clocks, etc. are irrelevant here).
+[[nodiscard]] constexpr chss::Board MakeExchangeMove(const chss::State& state, const chss::Move& move) {
+	auto board = state.board;
+	auto piece = board.At(move.from).value();
+	if (IsEnPassant(state, move)) {
+		board.At(chss::Position{.y = move.from.y, .x = move.to.x}) = std::nullopt;
+	}
+	if (move.promotionType.has_value()) {
+		piece.type = move.promotionType.value();
+	}
+	board.At(move.from) = std::nullopt;
+	board.At(move.to) = piece;
+	return board;
+}
+
+} // namespace detail
+
+namespace chss::evaluation {
+
+/**
+ * Static Exchange Evaluation: material balance, from the point of view of the side making the move, of the sequence of
+ * captures on move.to that follows the move. Each side recaptures with its least valuable attacker, and may stop
+ * capturing whenever continuing would lose material. X-ray attackers (sliders behind other attackers) join the
+ * exchange as soon as the piece in front of them has captured. Pins are not taken into account.
+ */
+[[nodiscard]] constexpr int SEE(const State& state, const Move& move) {
+	auto gains = std::array<int, 32>();
+	std::size_t depth = 0;
+	gains[0] = detail::MoveGain(state, move);
+	auto board = detail::MakeExchangeMove(state, move);
+	int valueOnSquare = PieceValue(board.At(move.to).value().type);
+	auto color = InverseColor(state.activeColor);
+	while (const auto attackerOpt = detail::FindLeastValuableAttacker(board, move.to, color)) {
+		++depth;
+		gains[depth] = valueOnSquare - gains[depth - 1];
+		const auto attacker = board.At(attackerOpt.value()).value();
+		board.At(attackerOpt.value()) = std::nullopt;
+		board.At(move.to) = attacker;
+		valueOnSquare = PieceValue(attacker.type);
+		color = InverseColor(color);
+	}
+	while (depth > 0) {
+		gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+		--depth;
+	}
+	return gains[0];
+}
+
+/**
+ * Same as SEE(state, move) >= threshold, but it stops resolving the exchange as soon as the outcome relative to the
+ * threshold is known, which is usually after one or two captures.
+ */
+[[nodiscard]] constexpr bool SEEGreaterOrEqual(const State& state, const Move& move, const int threshold) {
+	int swap = detail::MoveGain(state, move) - threshold;
+	if (swap < 0) {
+		return false;
+	}
+	auto board = detail::MakeExchangeMove(state, move);
+	swap = PieceValue(board.At(move.to).value().type) - swap;
+	if (swap <= 0) {
+		return true;
+	}
+	// result tells whether the side that made the move is winning the exchange when it is the turn of color.
+	bool result = true;
+	auto color = state.activeColor;
+	while (true) {
+		color = InverseColor(color);
+		const auto attackerOpt = detail::FindLeastValuableAttacker(board, move.to, color);
+		if (!attackerOpt.has_value()) {
+			break;
+		}
+		result = !result;
+		const auto attacker = board.At(attackerOpt.value()).value();
+		if (attacker.type == PieceType::King) {
+			// The king can only capture if the square is not defended anymore.
+			const auto defenderOpt = detail::FindLeastValuableAttacker(board, move.to, InverseColor(color));
+			return defenderOpt.has_value() ? !result : result;
+		}
+		swap = PieceValue(attacker.type) - swap;
+		if (swap < static_cast<int>(result)) {
+			break;
+		}
+		board.At(attackerOpt.value()) = std::nullopt;
+		board.At(move.to) = attacker;
+	}
+	return result;
+}
+
+} // namespace chss::evaluation
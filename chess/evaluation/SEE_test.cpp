@@ -0,0 +1,80 @@
+#include "SEE.h"
+
+#include "chess/fen/Fen.h"
+
+#include <test_utils/TestUtils.h>
+
+namespace {
+
+// SEEGreaterOrEqual has to agree with SEE right at the boundary.
+constexpr bool IsThresholdConsistent(const chss::State& state, const chss::Move& move) {
+	const auto see = chss::evaluation::SEE(state, move);
+	return chss::evaluation::SEEGreaterOrEqual(state, move, see - 1) &&
+		chss::evaluation::SEEGreaterOrEqual(state, move, see) &&
+		!chss::evaluation::SEEGreaterOrEqual(state, move, see + 1);
+}
+
+} // namespace
+
+TEST_CASE("SEE", "UndefendedPiece") {
+	constexpr auto state = chss::fen::Parse("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::E1, .to = chss::positions::E5, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == 100);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "XRayAttackersOnBothSides") {
+	constexpr auto state = chss::fen::Parse("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::D3, .to = chss::positions::E5, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == -200);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "XRayRecapture") {
+	constexpr auto state = chss::fen::Parse("4k3/2p5/3p4/8/8/8/3R4/3RK3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::D2, .to = chss::positions::D6, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == -300);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "QuietMoveToAttackedSquare") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/3p4/8/8/8/2Q1K3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::C1, .to = chss::positions::C4, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == -900);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "EnPassant") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::E5, .to = chss::positions::D6, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == 100);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "Promotion") {
+	constexpr auto state = chss::fen::Parse("4k3/1P6/8/8/8/8/8/4K3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::B7, .to = chss::positions::B8, .promotionType = chss::PieceType::Queen};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == 800);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "PromotionDefended") {
+	constexpr auto state = chss::fen::Parse("1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::A7, .to = chss::positions::A8, .promotionType = chss::PieceType::Queen};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == -100);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "KingCannotRecaptureDefendedPiece") {
+	constexpr auto state = chss::fen::Parse("8/8/2k5/3p4/4P3/8/8/3RK3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::E4, .to = chss::positions::D5, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == 100);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
+
+TEST_CASE("SEE", "KingRecapturesUndefendedPiece") {
+	constexpr auto state = chss::fen::Parse("8/8/2k5/3p4/4P3/8/8/4K3 w - - 0 1");
+	constexpr auto move = chss::Move{.from = chss::positions::E4, .to = chss::positions::D5, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::evaluation::SEE(state, move) == 0);
+	STATIC_REQUIRE(IsThresholdConsistent(state, move));
+}
@@ -119,33 +119,31 @@ constexpr chss::Color ParseActiveColor(const std::string_view& activeColorStr) {
 	return activeColorStr == "w" ? chss::Color::White : chss::Color::Black;
 }
 
-constexpr chss::CastlingAvailabilities ParseCastlingAvailabilities(const std::string_view& castlingAvailabilitiesStr) {
-	auto castlingAvailabilities = chss::CastlingAvailabilities{
-		.white = chss::CastlingAvailability{.isKingSideAvailable = false, .isQueenSideAvailable = false},
-		.black = chss::CastlingAvailability{.isKingSideAvailable = false, .isQueenSideAvailable = false}};
-	if (castlingAvailabilitiesStr == "-") {
-		return castlingAvailabilities;
+constexpr chss::CastlingRights ParseCastlingRights(const std::string_view& castlingRightsStr) {
+	auto castlingRights = chss::CastlingRights::None;
+	if (castlingRightsStr == "-") {
+		return castlingRights;
 	}
-	assert(castlingAvailabilitiesStr.size() <= 4);
-	for (const auto c : castlingAvailabilitiesStr) {
+	assert(castlingRightsStr.size() <= 4);
+	for (const auto c : castlingRightsStr) {
 		switch (c) {
 		case 'K':
-			castlingAvailabilities.white.isKingSideAvailable = true;
+			castlingRights |= chss::CastlingRights::WhiteKingSide;
 			break;
 		case 'Q':
-			castlingAvailabilities.white.isQueenSideAvailable = true;
+			castlingRights |= chss::CastlingRights::WhiteQueenSide;
 			break;
 		case 'k':
-			castlingAvailabilities.black.isKingSideAvailable = true;
+			castlingRights |= chss::CastlingRights::BlackKingSide;
 			break;
 		case 'q':
-			castlingAvailabilities.black.isQueenSideAvailable = true;
+			castlingRights |= chss::CastlingRights::BlackQueenSide;
 			break;
 		default:
 			assert(false);
 		}
 	}
-	return castlingAvailabilities;
+	return castlingRights;
 }
 
 constexpr std::optional<chss::Position> ParseEnPassantTargetSquare(const std::string_view& enPassantTargetSquareStr) {
@@ -281,24 +279,24 @@ constexpr char* SerializeActiveColor(char* out, chss::Color activeColor) {
 	return out;
 }
 
-constexpr char* SerializeCastlingAvailabilities(char* out, const chss::CastlingAvailabilities& castlingAvailabilities) {
+constexpr char* SerializeCastlingRights(char* out, chss::CastlingRights castlingRights) {
 	bool anyOutput = false;
-	if (castlingAvailabilities.white.isKingSideAvailable) {
+	if (chss::HasCastlingRights(castlingRights, chss::CastlingRights::WhiteKingSide)) {
 		*out = 'K';
 		++out;
 		anyOutput = true;
 	}
-	if (castlingAvailabilities.white.isQueenSideAvailable) {
+	if (chss::HasCastlingRights(castlingRights, chss::CastlingRights::WhiteQueenSide)) {
 		*out = 'Q';
 		++out;
 		anyOutput = true;
 	}
-	if (castlingAvailabilities.black.isKingSideAvailable) {
+	if (chss::HasCastlingRights(castlingRights, chss::CastlingRights::BlackKingSide)) {
 		*out = 'k';
 		++out;
 		anyOutput = true;
 	}
-	if (castlingAvailabilities.black.isQueenSideAvailable) {
+	if (chss::HasCastlingRights(castlingRights, chss::CastlingRights::BlackQueenSide)) {
 		*out = 'q';
 		++out;
 		anyOutput = true;
@@ -334,7 +332,7 @@ namespace chss::fen {
 	return State{
 		.board = detail::ParseBoard(fenParts[0]),
 		.activeColor = detail::ParseActiveColor(fenParts[1]),
-		.castlingAvailabilities = detail::ParseCastlingAvailabilities(fenParts[2]),
+		.castlingRights = detail::ParseCastlingRights(fenParts[2]),
 		.enPassantTargetSquare = detail::ParseEnPassantTargetSquare(fenParts[3]),
 		.halfmoveClock = detail::ParseInteger(fenParts[4]),
 		.fullmoveNumber = detail::ParseInteger(fenParts[5])};
@@ -349,7 +347,7 @@ namespace chss::fen {
 	out = detail::SerializeActiveColor(out, state.activeColor);
 	*out = ' ';
 	++out;
-	out = detail::SerializeCastlingAvailabilities(out, state.castlingAvailabilities);
+	out = detail::SerializeCastlingRights(out, state.castlingRights);
 	*out = ' ';
 	++out;
 	out = detail::SerializeEnPassantTargetSquare(out, state.enPassantTargetSquare);
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+
+#include <utility>
+#include <variant>
+
+namespace detail {
+
+/**
+ * The moves of Generator<kColor>, with kColor the active color of the state, for the callers that only know it at run
+ * time. Every step of the iteration dispatches on the color, so the search picks the instantiation itself instead, once
+ * per node.
+ */
+template<template<chss::Color> class Generator>
+class ActiveColorGenerator {
+	using WhiteGenerator = Generator<chss::Color::White>;
+	using BlackGenerator = Generator<chss::Color::Black>;
+
+	template<typename ColorGenerator>
+	struct Range {
+		typename ColorGenerator::Iterator it;
+		typename ColorGenerator::Sentinel end;
+	};
+
+public:
+	class Sentinel {};
+
+	class Iterator {
+	public:
+		template<typename ColorGenerator>
+		constexpr explicit Iterator(const ColorGenerator& generator)
+			: mRange(Range<ColorGenerator>{.it = generator.begin(), .end = generator.end()}) {}
+
+		[[nodiscard]] constexpr chss::Move operator*() const {
+			return std::visit([](const auto& range) -> chss::Move { return *range.it; }, mRange);
+		}
+
+		constexpr Iterator& operator++() {
+			std::visit([](auto& range) { ++range.it; }, mRange);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr bool operator==(const Sentinel&) const {
+			return std::visit([](const auto& range) { return range.it == range.end; }, mRange);
+		}
+
+		[[nodiscard]] constexpr bool operator!=(const Sentinel&) const {
+			return std::visit([](const auto& range) { return range.it != range.end; }, mRange);
+		}
+
+	private:
+		std::variant<Range<WhiteGenerator>, Range<BlackGenerator>> mRange;
+	};
+
+	// The arguments after the state are the ones of the generator (such as the position of the piece).
+	template<typename... Args>
+	constexpr explicit ActiveColorGenerator(const chss::State& state, const Args&... args)
+		: mGenerator(MakeGenerator(state, args...)) {}
+
+	[[nodiscard]] constexpr Iterator begin() const {
+		return std::visit([](const auto& generator) { return Iterator(generator); }, mGenerator);
+	}
+
+	[[nodiscard]] constexpr Sentinel end() const {
+		return Sentinel{};
+	}
+
+private:
+	template<typename... Args>
+	[[nodiscard]] static constexpr std::variant<WhiteGenerator, BlackGenerator> MakeGenerator(
+		const chss::State& state,
+		const Args&... args) {
+		if (state.activeColor == chss::Color::White) {
+			return WhiteGenerator(state, args...);
+		}
+		return BlackGenerator(state, args...);
+	}
+
+	std::variant<WhiteGenerator, BlackGenerator> mGenerator;
+};
+
+} // namespace detail
@@ -0,0 +1,235 @@
+#pragma once
+
+#ifdef CHSS_MAILBOX_BOARD
+#error "The mailbox board walks the rays instead of using the attack tables"
+#endif
+
+#include "chess/representation/Board.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace detail {
+
+// Lookup tables of the board geometry, computed at compile time. They are computed from the coordinates of the squares
+// rather than from the offset arrays of the move generators, so that the tests can check the ones against the others.
+
+template<typename T>
+using SquareTable = std::array<T, 64>;
+
+template<typename T>
+using SquarePairTable = std::array<std::array<T, 64>, 64>;
+
+[[nodiscard]] constexpr int Abs(const int value) {
+	return value < 0 ? -value : value;
+}
+
+[[nodiscard]] constexpr int Sign(const int value) {
+	return (value > 0) - (value < 0);
+}
+
+// The squares to whose offset from the square isTarget(deltaY, deltaX) is true.
+template<typename IsTarget>
+[[nodiscard]] constexpr SquareTable<chss::Bitboard> CreateStepAttacks(const IsTarget& isTarget) {
+	auto attacks = SquareTable<chss::Bitboard>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		for (std::size_t to = 0; to < 64; ++to) {
+			const auto delta = chss::SquarePosition(to) - chss::SquarePosition(from);
+			if (isTarget(delta.deltaY, delta.deltaX)) {
+				attacks[from] |= chss::SquareBitboard(chss::SquarePosition(to));
+			}
+		}
+	}
+	return attacks;
+}
+
+constexpr auto kKnightAttacks =
+	CreateStepAttacks([](const int deltaY, const int deltaX) { return Abs(deltaY) * Abs(deltaX) == 2; });
+
+constexpr auto kKingAttacks = CreateStepAttacks([](const int deltaY, const int deltaX) {
+	return (deltaY != 0 || deltaX != 0) && Abs(deltaY) <= 1 && Abs(deltaX) <= 1;
+});
+
+// Indexed by the color of the pawn.
+constexpr auto kPawnAttacks = std::array<SquareTable<chss::Bitboard>, 2>{
+	CreateStepAttacks([](const int deltaY, const int deltaX) { return deltaY == +1 && Abs(deltaX) == 1; }),
+	CreateStepAttacks([](const int deltaY, const int deltaX) { return deltaY == -1 && Abs(deltaX) == 1; })};
+
+// The unit step from a square towards the other one, or {0, 0} if they are not on a same rank, file or diagonal.
+constexpr auto kRayDirections = [] {
+	auto directions = SquarePairTable<matrix::Direction2D>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		for (std::size_t to = 0; to < 64; ++to) {
+			const auto delta = chss::SquarePosition(to) - chss::SquarePosition(from);
+			const auto isAligned = from != to &&
+				(delta.deltaY == 0 || delta.deltaX == 0 || Abs(delta.deltaY) == Abs(delta.deltaX));
+			if (isAligned) {
+				directions[from][to] = matrix::Direction2D{.deltaY = Sign(delta.deltaY), .deltaX = Sign(delta.deltaX)};
+			}
+		}
+	}
+	return directions;
+}();
+
+// The directions of the rays of the sliding pieces. The first 4 go towards higher square indices, the last 4 are their
+// opposites.
+constexpr auto kRayDirectionsOfSliders = std::array<matrix::Direction2D, 8>{
+	matrix::Direction2D{.deltaY = 0, .deltaX = +1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = -1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = 0},
+	matrix::Direction2D{.deltaY = +1, .deltaX = +1},
+	matrix::Direction2D{.deltaY = 0, .deltaX = -1},
+	matrix::Direction2D{.deltaY = -1, .deltaX = +1},
+	matrix::Direction2D{.deltaY = -1, .deltaX = 0},
+	matrix::Direction2D{.deltaY = -1, .deltaX = -1}};
+
+// The squares from a square to the edge of the board in each direction of kRayDirectionsOfSliders, without the square.
+constexpr auto kRays = [] {
+	auto rays = std::array<SquareTable<chss::Bitboard>, kRayDirectionsOfSliders.size()>();
+	for (std::size_t i = 0; i < kRayDirectionsOfSliders.size(); ++i) {
+		for (std::size_t from = 0; from < 64; ++from) {
+			for (auto position = chss::SquarePosition(from) + kRayDirectionsOfSliders[i];
+				 matrix::IsInside(matrix::Size2D{.sizeY = 8, .sizeX = 8}, position);
+				 position += kRayDirectionsOfSliders[i]) {
+				rays[i][from] |= chss::SquareBitboard(position);
+			}
+		}
+	}
+	return rays;
+}();
+
+// The squares that a bishop or a rook attacks from each square on an empty board.
+constexpr auto kDiagonalRays = [] {
+	auto rays = SquareTable<chss::Bitboard>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		rays[from] = kRays[1][from] | kRays[3][from] | kRays[5][from] | kRays[7][from];
+	}
+	return rays;
+}();
+
+constexpr auto kOrthogonalRays = [] {
+	auto rays = SquareTable<chss::Bitboard>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		rays[from] = kRays[0][from] | kRays[2][from] | kRays[4][from] | kRays[6][from];
+	}
+	return rays;
+}();
+
+// The squares strictly between two aligned squares.
+constexpr auto kBetween = [] {
+	auto between = SquarePairTable<chss::Bitboard>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		for (std::size_t to = 0; to < 64; ++to) {
+			const auto direction = kRayDirections[from][to];
+			if (direction == matrix::Direction2D{.deltaY = 0, .deltaX = 0}) {
+				continue;
+			}
+			for (auto position = chss::SquarePosition(from) + direction; position != chss::SquarePosition(to);
+				 position += direction) {
+				between[from][to] |= chss::SquareBitboard(position);
+			}
+		}
+	}
+	return between;
+}();
+
+// The whole rank, file or diagonal through two aligned squares, from one edge of the board to the other.
+constexpr auto kLines = [] {
+	auto lines = SquarePairTable<chss::Bitboard>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		for (std::size_t to = 0; to < 64; ++to) {
+			const auto direction = kRayDirections[from][to];
+			if (direction == matrix::Direction2D{.deltaY = 0, .deltaX = 0}) {
+				continue;
+			}
+			lines[from][to] = chss::SquareBitboard(chss::SquarePosition(from));
+			for (const auto step : {direction, direction * -1}) {
+				for (auto position = chss::SquarePosition(from) + step;
+					 matrix::IsInside(matrix::Size2D{.sizeY = 8, .sizeX = 8}, position);
+					 position += step) {
+					lines[from][to] |= chss::SquareBitboard(position);
+				}
+			}
+		}
+	}
+	return lines;
+}();
+
+template<typename Distance>
+[[nodiscard]] constexpr SquarePairTable<std::uint8_t> CreateDistances(const Distance& distance) {
+	auto distances = SquarePairTable<std::uint8_t>();
+	for (std::size_t from = 0; from < 64; ++from) {
+		for (std::size_t to = 0; to < 64; ++to) {
+			const auto delta = chss::SquarePosition(to) - chss::SquarePosition(from);
+			distances[from][to] = static_cast<std::uint8_t>(distance(Abs(delta.deltaY), Abs(delta.deltaX)));
+		}
+	}
+	return distances;
+}
+
+constexpr auto kChebyshevDistances =
+	CreateDistances([](const int deltaY, const int deltaX) { return deltaY > deltaX ? deltaY : deltaX; });
+
+constexpr auto kManhattanDistances =
+	CreateDistances([](const int deltaY, const int deltaX) { return deltaY + deltaX; });
+
+} // namespace detail
+
+namespace chss::move_generation {
+
+[[nodiscard]] constexpr Bitboard KnightAttacks(const Position& square) {
+	return detail::kKnightAttacks[SquareIndex(square)];
+}
+
+[[nodiscard]] constexpr Bitboard KingAttacks(const Position& square) {
+	return detail::kKingAttacks[SquareIndex(square)];
+}
+
+// The squares that a pawn of the given color attacks from the square.
+[[nodiscard]] constexpr Bitboard PawnAttacks(const Color pawnColor, const Position& square) {
+	return detail::kPawnAttacks[static_cast<std::size_t>(pawnColor)][SquareIndex(square)];
+}
+
+// The unit step from one square towards the other one, or {0, 0} if they are not on a same rank, file or diagonal.
+[[nodiscard]] constexpr matrix::Direction2D RayDirection(const Position& from, const Position& to) {
+	return detail::kRayDirections[SquareIndex(from)][SquareIndex(to)];
+}
+
+// The squares strictly between two squares on a same rank, file or diagonal, 0 if they are not.
+[[nodiscard]] constexpr Bitboard Between(const Position& from, const Position& to) {
+	return detail::kBetween[SquareIndex(from)][SquareIndex(to)];
+}
+
+// The rank, file or diagonal through two squares from one edge of the board to the other, 0 if there is none.
+[[nodiscard]] constexpr Bitboard Line(const Position& from, const Position& to) {
+	return detail::kLines[SquareIndex(from)][SquareIndex(to)];
+}
+
+// The squares from the square to the edge of the board in the ray direction (an index in
+// detail::kRayDirectionsOfSliders), without the square.
+[[nodiscard]] constexpr Bitboard Ray(const std::size_t rayDirectionIndex, const Position& square) {
+	return detail::kRays[rayDirectionIndex][SquareIndex(square)];
+}
+
+// The squares that a bishop attacks from the square on an empty board.
+[[nodiscard]] constexpr Bitboard DiagonalRays(const Position& square) {
+	return detail::kDiagonalRays[SquareIndex(square)];
+}
+
+// The squares that a rook attacks from the square on an empty board.
+[[nodiscard]] constexpr Bitboard OrthogonalRays(const Position& square) {
+	return detail::kOrthogonalRays[SquareIndex(square)];
+}
+
+// The number of king steps between two squares.
+[[nodiscard]] constexpr int ChebyshevDistance(const Position& from, const Position& to) {
+	return detail::kChebyshevDistances[SquareIndex(from)][SquareIndex(to)];
+}
+
+// The number of rook steps of one square between two squares.
+[[nodiscard]] constexpr int ManhattanDistance(const Position& from, const Position& to) {
+	return detail::kManhattanDistances[SquareIndex(from)][SquareIndex(to)];
+}
+
+} // namespace chss::move_generation
@@ -0,0 +1,157 @@
+#include "AttackTables.h"
+
+#include "chess/move_generation/IsInCheck.h"
+#include "chess/move_generation/pieces/KingMoves.h"
+#include "chess/move_generation/pieces/KnightMoves.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <algorithm>
+#include <span>
+
+namespace {
+
+constexpr auto kBoardSize = matrix::Size2D{.sizeY = 8, .sizeX = 8};
+
+// The squares one offset away from the square.
+[[nodiscard]] constexpr chss::Bitboard OffsetSquares(
+	const chss::Position& square,
+	const std::span<const matrix::Direction2D> offsets) {
+	chss::Bitboard squares = 0;
+	for (const auto offset : offsets) {
+		if (matrix::IsInside(kBoardSize, square + offset)) {
+			squares |= chss::SquareBitboard(square + offset);
+		}
+	}
+	return squares;
+}
+
+template<typename Attacks>
+[[nodiscard]] constexpr bool AreOffsetSquaresOnAllSquares(
+	const Attacks& attacks,
+	const std::span<const matrix::Direction2D> offsets) {
+	for (std::size_t i = 0; i < 64; ++i) {
+		if (attacks(chss::SquarePosition(i)) != OffsetSquares(chss::SquarePosition(i), offsets)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// The number of steps by the offsets from a square to each square, by breadth-first search.
+[[nodiscard]] constexpr std::array<int, 64> StepDistances(
+	const chss::Position& from,
+	const std::span<const matrix::Direction2D> offsets) {
+	auto distances = std::array<int, 64>();
+	distances.fill(-1);
+	distances[chss::SquareIndex(from)] = 0;
+	for (int distance = 0; std::ranges::find(distances, -1) != distances.end(); ++distance) {
+		for (std::size_t i = 0; i < 64; ++i) {
+			if (distances[i] != distance) {
+				continue;
+			}
+			for (const auto offset : offsets) {
+				const auto to = chss::SquarePosition(i) + offset;
+				if (matrix::IsInside(kBoardSize, to) && distances[chss::SquareIndex(to)] == -1) {
+					distances[chss::SquareIndex(to)] = distance + 1;
+				}
+			}
+		}
+	}
+	return distances;
+}
+
+template<typename Distance>
+[[nodiscard]] constexpr bool AreStepDistancesOnAllSquares(
+	const Distance& distance,
+	const std::span<const matrix::Direction2D> offsets) {
+	for (std::size_t from = 0; from < 64; ++from) {
+		const auto distances = StepDistances(chss::SquarePosition(from), offsets);
+		for (std::size_t to = 0; to < 64; ++to) {
+			if (distance(chss::SquarePosition(from), chss::SquarePosition(to)) != distances[to]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Walks the 8 rays of the sliding pieces from every square, and checks the direction and the squares in between of
+// every square of the rays. The squares out of the rays must have no direction, no squares in between and no line.
+[[nodiscard]] constexpr bool AreRaysOnAllSquares() {
+	auto rayOffsets = std::array<matrix::Direction2D, 8>();
+	std::ranges::copy(detail::kBishopAttackOffsets, rayOffsets.begin());
+	std::ranges::copy(detail::kRookAttackOffsets, rayOffsets.begin() + 4);
+	for (std::size_t from = 0; from < 64; ++from) {
+		const auto fromPosition = chss::SquarePosition(from);
+		chss::Bitboard raySquares = 0;
+		for (const auto offset : rayOffsets) {
+			const auto lineSquares = OffsetSquares(fromPosition, std::array{offset}) |
+				OffsetSquares(fromPosition, std::array{offset * -1}) | chss::SquareBitboard(fromPosition);
+			chss::Bitboard between = 0;
+			for (auto to = fromPosition + offset; matrix::IsInside(kBoardSize, to); to += offset) {
+				if (chss::move_generation::RayDirection(fromPosition, to) != offset ||
+					chss::move_generation::Between(fromPosition, to) != between ||
+					(chss::move_generation::Line(fromPosition, to) & lineSquares) != lineSquares) {
+					return false;
+				}
+				between |= chss::SquareBitboard(to);
+			}
+			raySquares |= between;
+		}
+		for (std::size_t to = 0; to < 64; ++to) {
+			const auto toPosition = chss::SquarePosition(to);
+			if ((raySquares & chss::SquareBitboard(toPosition)) == 0 &&
+				(chss::move_generation::RayDirection(fromPosition, toPosition) !=
+					 matrix::Direction2D{.deltaY = 0, .deltaX = 0} ||
+				 chss::move_generation::Between(fromPosition, toPosition) != 0 ||
+				 chss::move_generation::Line(fromPosition, toPosition) != 0)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+TEST_CASE("AttackTables", "KnightAttacks_AreTheKnightOffsets") {
+	STATIC_REQUIRE(AreOffsetSquaresOnAllSquares(chss::move_generation::KnightAttacks, detail::kKnightAttackOffsets));
+	STATIC_REQUIRE(AreOffsetSquaresOnAllSquares(chss::move_generation::KnightAttacks, detail::kKnightMoveOffsets));
+	STATIC_REQUIRE(chss::move_generation::KnightAttacks(chss::positions::A1) ==
+		(chss::SquareBitboard(chss::positions::B3) | chss::SquareBitboard(chss::positions::C2)));
+}
+
+TEST_CASE("AttackTables", "KingAttacks_AreTheKingOffsets") {
+	STATIC_REQUIRE(AreOffsetSquaresOnAllSquares(chss::move_generation::KingAttacks, detail::kKingAttackOffsets));
+	// Without the two castling offsets.
+	STATIC_REQUIRE(AreOffsetSquaresOnAllSquares(
+		chss::move_generation::KingAttacks, std::span(detail::kKingMoveOffsets).first<8>()));
+}
+
+// A pawn of a color attacks the squares from which a pawn of the other color would attack it.
+TEST_CASE("AttackTables", "PawnAttacks_AreThePawnAttackerOffsets") {
+	STATIC_REQUIRE(AreOffsetSquaresOnAllSquares(
+		[](const chss::Position& square) { return chss::move_generation::PawnAttacks(chss::Color::White, square); },
+		detail::PawnAttackerOffsets(chss::Color::Black)));
+	STATIC_REQUIRE(AreOffsetSquaresOnAllSquares(
+		[](const chss::Position& square) { return chss::move_generation::PawnAttacks(chss::Color::Black, square); },
+		detail::PawnAttackerOffsets(chss::Color::White)));
+	STATIC_REQUIRE(chss::move_generation::PawnAttacks(chss::Color::White, chss::positions::E4) ==
+		(chss::SquareBitboard(chss::positions::D5) | chss::SquareBitboard(chss::positions::F5)));
+}
+
+TEST_CASE("AttackTables", "RayDirectionBetweenAndLine_FollowTheRaysOfTheSlidingPieces") {
+	STATIC_REQUIRE(AreRaysOnAllSquares());
+	STATIC_REQUIRE(chss::move_generation::Between(chss::positions::C1, chss::positions::F4) ==
+		(chss::SquareBitboard(chss::positions::D2) | chss::SquareBitboard(chss::positions::E3)));
+	STATIC_REQUIRE(chss::move_generation::Line(chss::positions::B2, chss::positions::B5) == 0x0202020202020202ULL);
+	STATIC_REQUIRE(chss::move_generation::Line(chss::positions::A1, chss::positions::B2) == 0x8040201008040201ULL);
+}
+
+TEST_CASE("AttackTables", "Distances_AreTheNumbersOfKingAndRookSteps") {
+	STATIC_REQUIRE(AreStepDistancesOnAllSquares(chss::move_generation::ChebyshevDistance, detail::kKingAttackOffsets));
+	STATIC_REQUIRE(AreStepDistancesOnAllSquares(chss::move_generation::ManhattanDistance, detail::kRookAttackOffsets));
+	STATIC_REQUIRE(chss::move_generation::ChebyshevDistance(chss::positions::A1, chss::positions::H8) == 7);
+	STATIC_REQUIRE(chss::move_generation::ManhattanDistance(chss::positions::A1, chss::positions::H8) == 14);
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#ifndef CHSS_MAILBOX_BOARD
+#include "chess/move_generation/AttackTables.h"
+#endif
+#include "chess/move_generation/IsInCheck.h"
+#include "chess/move_generation/MakeMove.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+
+namespace detail {
+
+#ifdef CHSS_MAILBOX_BOARD
+
+// Whether a sliding piece that moves to move.to attacks the king along one of the offsets. move.from is empty then.
+template<std::size_t N>
+[[nodiscard]] constexpr bool AttacksAlongAnyOffset(
+	const chss::Board& board,
+	const chss::Move& move,
+	const chss::Position& kingPosition,
+	const std::array<matrix::Direction2D, N>& offsets) {
+	for (const auto offset : offsets) {
+		if (IsOnRay(move.to, offset, kingPosition)) {
+			auto position = move.to + offset;
+			while (position != kingPosition && (position == move.from || !board.At(position).has_value())) {
+				position += offset;
+			}
+			return position == kingPosition;
+		}
+	}
+	return false;
+}
+
+#else
+
+/**
+ * The piece bitboards after the pseudo-legal move of kColor, without playing it on the board. Unlike
+ * IsKingSafeAfterMove, it moves the pieces in the type bitboards too, so that the attackers of both colors are right.
+ */
+template<chss::Color kColor>
+[[nodiscard]] constexpr chss::move_generation::PieceBitboards PieceBitboardsAfterMove(
+	const chss::State& state,
+	const chss::move_generation::PieceBitboards& bitboards,
+	const chss::Move& move) {
+	constexpr auto kOwnIndex = static_cast<std::size_t>(kColor);
+	constexpr auto kEnemyIndex = static_cast<std::size_t>(chss::InverseColor(kColor));
+	constexpr auto kPawnIndex = static_cast<std::size_t>(chss::PieceType::Pawn);
+	constexpr auto kRookIndex = static_cast<std::size_t>(chss::PieceType::Rook);
+	auto newBitboards = bitboards;
+	const auto toSquare = chss::SquareBitboard(move.to);
+	const auto& capturedOpt = state.board.At(move.to);
+	if (capturedOpt.has_value()) {
+		newBitboards.byColor[kEnemyIndex] ^= toSquare;
+		newBitboards.byType[static_cast<std::size_t>(capturedOpt.value().type)] ^= toSquare;
+	}
+	const auto fromToSquares = chss::SquareBitboard(move.from) | toSquare;
+	newBitboards.byColor[kOwnIndex] ^= fromToSquares;
+	newBitboards.byType[static_cast<std::size_t>(state.board.At(move.from).value().type)] ^= fromToSquares;
+	switch (chss::move_generation::GetMoveKind(state, move)) {
+	case chss::move_generation::MoveKind::EnPassant: {
+		const auto capturedSquare = chss::SquareBitboard(chss::Position{.y = move.from.y, .x = move.to.x});
+		newBitboards.byColor[kEnemyIndex] ^= capturedSquare;
+		newBitboards.byType[kPawnIndex] ^= capturedSquare;
+		break;
+	}
+	case chss::move_generation::MoveKind::Promotion:
+		newBitboards.byType[kPawnIndex] ^= toSquare;
+		newBitboards.byType[static_cast<std::size_t>(move.promotionType.value())] ^= toSquare;
+		break;
+	case chss::move_generation::MoveKind::Castling: {
+		const auto rookMove = chss::move_generation::CastlingRookMove<kColor>(move);
+		const auto rookSquares = chss::SquareBitboard(rookMove.from) | chss::SquareBitboard(rookMove.to);
+		newBitboards.byColor[kOwnIndex] ^= rookSquares;
+		newBitboards.byType[kRookIndex] ^= rookSquares;
+		break;
+	}
+	default:
+		break;
+	}
+	return newBitboards;
+}
+
+#endif
+
+} // namespace detail
+
+namespace chss::move_generation {
+
+#ifdef CHSS_MAILBOX_BOARD
+
+/**
+ * What GivesCheck needs to know about a position, computed once for all its moves. The mailbox board has no attack
+ * tables: the discovered check candidates are found by walking the rays from the enemy king.
+ */
+struct CheckInfo {
+	Position enemyKingPosition;
+	// The pieces of the active color that are the only piece between one of its sliding pieces and the enemy king:
+	// moving them out of that ray gives a discovered check.
+	detail::Pins discoveredCheckCandidates;
+};
+
+template<Color kColor>
+[[nodiscard]] constexpr CheckInfo ComputeCheckInfo(const State& state) {
+	assert(state.activeColor == kColor);
+	const auto enemyKing = FindKing(state.board, InverseColor(kColor));
+	return CheckInfo{
+		.enemyKingPosition = enemyKing,
+		.discoveredCheckCandidates = detail::FindPins(state.board, enemyKing, kColor, kColor)};
+}
+
+/**
+ * Whether the pseudo-legal move of kColor checks the enemy king, without making it: whether the piece attacks the king
+ * from move.to, or uncovers a sliding piece. Promotions, en passant captures and castling change more than the two
+ * squares of the move, so they are played instead, and the rays are walked from the king (see IsInCheck).
+ */
+template<Color kColor>
+[[nodiscard]] constexpr bool GivesCheck(const State& state, const CheckInfo& checkInfo, const Move& move) {
+	constexpr auto kEnemy = InverseColor(kColor);
+	const auto enemyKing = checkInfo.enemyKingPosition;
+	const auto moveKind = GetMoveKind(state, move);
+	if (moveKind == MoveKind::Promotion || moveKind == MoveKind::EnPassant || moveKind == MoveKind::Castling) {
+		return IsInCheck<kEnemy>(MakeMove(state, move).board, enemyKing);
+	}
+	for (const auto& candidate : checkInfo.discoveredCheckCandidates) {
+		if (candidate.position == move.from && !detail::IsOnRay(enemyKing, candidate.direction, move.to)) {
+			return true;
+		}
+	}
+	const auto pieceType = state.board.At(move.from).value().type;
+	const auto delta = enemyKing - move.to;
+	switch (pieceType) {
+	case PieceType::Pawn:
+		return delta.deltaY == (kColor == Color::White ? 1 : -1) && (delta.deltaX == -1 || delta.deltaX == +1);
+	case PieceType::Knight:
+		return delta.deltaY * delta.deltaX == 2 || delta.deltaY * delta.deltaX == -2;
+	case PieceType::King:
+		return false;
+	default:
+		return (pieceType != PieceType::Rook &&
+				detail::AttacksAlongAnyOffset(state.board, move, enemyKing, detail::kBishopAttackOffsets)) ||
+			(pieceType != PieceType::Bishop &&
+			 detail::AttacksAlongAnyOffset(state.board, move, enemyKing, detail::kRookAttackOffsets));
+	}
+}
+
+#else
+
+/**
+ * What GivesCheck needs to know about a position, computed once for all its moves.
+ */
+struct CheckInfo {
+	PieceBitboards bitboards;
+	Position enemyKingPosition;
+	// By piece type, the squares from which a piece of the active color would attack the enemy king.
+	std::array<Bitboard, 6> checkSquares;
+	// The pieces of the active color that are the only piece between one of its sliding pieces and the enemy king:
+	// moving them out of that line gives a discovered check.
+	Bitboard discoveredCheckCandidates;
+};
+
+template<Color kColor>
+[[nodiscard]] constexpr CheckInfo ComputeCheckInfo(const State& state) {
+	assert(state.activeColor == kColor);
+	constexpr auto kEnemy = InverseColor(kColor);
+	auto checkInfo = CheckInfo{
+		.bitboards = ToPieceBitboards(state.board),
+		.enemyKingPosition = Position{.y = -1, .x = -1},
+		.checkSquares = {},
+		.discoveredCheckCandidates = 0};
+	const auto& bitboards = checkInfo.bitboards;
+	const auto enemyKing =
+		SquarePosition(static_cast<std::size_t>(std::countr_zero(bitboards.Get(kEnemy, PieceType::King))));
+	checkInfo.enemyKingPosition = enemyKing;
+
+	const auto occupied = bitboards.GetOccupied();
+	const auto bishopCheckSquares = BishopAttacks(enemyKing, occupied);
+	const auto rookCheckSquares = RookAttacks(enemyKing, occupied);
+	checkInfo.checkSquares[static_cast<std::size_t>(PieceType::Pawn)] = PawnAttacks(kEnemy, enemyKing);
+	checkInfo.checkSquares[static_cast<std::size_t>(PieceType::Knight)] = KnightAttacks(enemyKing);
+	checkInfo.checkSquares[static_cast<std::size_t>(PieceType::Bishop)] = bishopCheckSquares;
+	checkInfo.checkSquares[static_cast<std::size_t>(PieceType::Rook)] = rookCheckSquares;
+	checkInfo.checkSquares[static_cast<std::size_t>(PieceType::Queen)] = bishopCheckSquares | rookCheckSquares;
+
+	const auto queens = bitboards.Get(kColor, PieceType::Queen);
+	auto sliders = (DiagonalRays(enemyKing) & (bitboards.Get(kColor, PieceType::Bishop) | queens)) |
+		(OrthogonalRays(enemyKing) & (bitboards.Get(kColor, PieceType::Rook) | queens));
+	for (; sliders != 0; sliders &= sliders - 1) {
+		const auto slider = SquarePosition(static_cast<std::size_t>(std::countr_zero(sliders)));
+		const auto blockers = Between(enemyKing, slider) & occupied;
+		if (std::has_single_bit(blockers) && (blockers & bitboards.byColor[static_cast<std::size_t>(kColor)]) != 0) {
+			checkInfo.discoveredCheckCandidates |= blockers;
+		}
+	}
+	return checkInfo;
+}
+
+/**
+ * Whether the pseudo-legal move of kColor checks the enemy king, without making it. Promotions, en passant captures
+ * and castling change more than the two squares of the move, so they are played on the bitboards instead.
+ */
+template<Color kColor>
+[[nodiscard]] constexpr bool GivesCheck(const State& state, const CheckInfo& checkInfo, const Move& move) {
+	const auto moveKind = GetMoveKind(state, move);
+	if (moveKind == MoveKind::Promotion || moveKind == MoveKind::EnPassant || moveKind == MoveKind::Castling) {
+		return IsSquareAttacked(
+			detail::PieceBitboardsAfterMove<kColor>(state, checkInfo.bitboards, move),
+			checkInfo.enemyKingPosition,
+			kColor);
+	}
+	const auto pieceType = state.board.At(move.from).value().type;
+	if ((checkInfo.checkSquares[static_cast<std::size_t>(pieceType)] & SquareBitboard(move.to)) != 0) {
+		return true;
+	}
+	return (checkInfo.discoveredCheckCandidates & SquareBitboard(move.from)) != 0 &&
+		(Line(checkInfo.enemyKingPosition, move.from) & SquareBitboard(move.to)) == 0;
+}
+
+#endif
+
+template<Color kColor>
+[[nodiscard]] constexpr bool GivesCheck(const State& state, const Move& move) {
+	return GivesCheck<kColor>(state, ComputeCheckInfo<kColor>(state), move);
+}
+
+[[nodiscard]] constexpr bool GivesCheck(const State& state, const Move& move) {
+	if (state.activeColor == Color::White) {
+		return GivesCheck<Color::White>(state, move);
+	}
+	return GivesCheck<Color::Black>(state, move);
+}
+
+} // namespace chss::move_generation
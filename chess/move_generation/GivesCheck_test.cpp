@@ -0,0 +1,88 @@
+#include "GivesCheck.h"
+
+#include "chess/fen/Fen.h"
+#include "chess/move_generation/RandomGames.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+TEST_CASE("GivesCheck", "DirectChecks") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/3P4/RN2KB2 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::A8, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::B1, .to = chss::positions::C3, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::F1, .to = chss::positions::A6, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::F1, .to = chss::positions::B5, .promotionType = std::nullopt}));
+}
+
+TEST_CASE("GivesCheck", "PawnAndKnightChecks") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/5P2/8/2N5/8/4K3 w - - 0 1");
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::C3, .to = chss::positions::D5, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::F5, .to = chss::positions::F6, .promotionType = std::nullopt}));
+	constexpr auto knightState = chss::fen::Parse("4k3/8/8/3N4/8/8/8/4K3 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(knightState, chss::Move{.from = chss::positions::D5, .to = chss::positions::F6, .promotionType = std::nullopt}));
+	constexpr auto pawnState = chss::fen::Parse("4k3/8/5P2/8/8/8/8/4K3 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(pawnState, chss::Move{.from = chss::positions::F6, .to = chss::positions::F7, .promotionType = std::nullopt}));
+}
+
+TEST_CASE("GivesCheck", "DiscoveredChecks") {
+	// The knight on e4 blocks the rook on e1, the bishop on d2 blocks no line to the king.
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/4N3/8/3B4/4R1K1 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::E4, .to = chss::positions::C3, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(state, chss::Move{.from = chss::positions::D2, .to = chss::positions::E3, .promotionType = std::nullopt}));
+	// Along the line of the check, the piece still blocks it.
+	constexpr auto pawnState = chss::fen::Parse("4k3/8/8/8/4P3/8/8/4R1K1 w - - 0 1");
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(pawnState, chss::Move{.from = chss::positions::E4, .to = chss::positions::E5, .promotionType = std::nullopt}));
+}
+
+TEST_CASE("GivesCheck", "SpecialMoves") {
+	constexpr auto promotionState = chss::fen::Parse("1n2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(promotionState, chss::Move{.from = chss::positions::A7, .to = chss::positions::B8, .promotionType = chss::PieceType::Queen}));
+	STATIC_REQUIRE(!chss::move_generation::GivesCheck(promotionState, chss::Move{.from = chss::positions::A7, .to = chss::positions::B8, .promotionType = chss::PieceType::Knight}));
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(promotionState, chss::Move{.from = chss::positions::A7, .to = chss::positions::B8, .promotionType = chss::PieceType::Rook}));
+	// Capturing en passant removes the last piece between the rook on a5 and the king on h5.
+	constexpr auto enPassantState = chss::fen::Parse("8/8/8/R2pP2k/8/8/8/4K3 w - d6 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(enPassantState, chss::Move{.from = chss::positions::E5, .to = chss::positions::D6, .promotionType = std::nullopt}));
+	// The rook that castles checks the king on f8.
+	constexpr auto castlingState = chss::fen::Parse("5k2/8/8/8/8/8/8/4K2R w K - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GivesCheck(castlingState, chss::Move{.from = chss::positions::E1, .to = chss::positions::G1, .promotionType = std::nullopt}));
+}
+
+namespace {
+
+/**
+ * Compares GivesCheck with making each legal move and looking for the check, in the positions of random games. Returns
+ * the number of compared moves.
+ */
+std::int64_t CompareWithMakeMove(const int numPositions) {
+	std::int64_t numComparedMoves = 0;
+	chss::move_generation::ForEachRandomGamePosition(
+		numPositions,
+		[&numComparedMoves](const chss::State& state, const std::vector<chss::Move>& legalMoves) {
+			for (const auto& move : legalMoves) {
+				const auto newState = chss::move_generation::MakeMove(state, move);
+				const auto isInCheck = chss::move_generation::IsInCheck(
+					newState.board,
+					newState.activeColor,
+					chss::move_generation::FindKing(newState.board, newState.activeColor));
+				EXPECT_EQ(chss::move_generation::GivesCheck(state, move), isInCheck)
+					<< chss::fen::Serialize(state) << " " << move.from.y << move.from.x << move.to.y << move.to.x;
+			}
+			numComparedMoves += static_cast<std::int64_t>(legalMoves.size());
+		});
+	return numComparedMoves;
+}
+
+} // namespace
+
+TEST(GivesCheck, SameAsMakeMoveAndIsInCheck) {
+	EXPECT_GT(CompareWithMakeMove(5000), 5000);
+}
+
+TEST(GivesCheck, DISABLED_SameAsMakeMoveAndIsInCheckOnMillionsOfPositions) {
+	EXPECT_GT(CompareWithMakeMove(2000000), 2000000);
+}
@@ -1,13 +1,176 @@
 #pragma once
 
+#ifndef CHSS_MAILBOX_BOARD
+#include "chess/move_generation/AttackTables.h"
+#endif
 #include "chess/representation/Board.h"
 
+#include <cpp_utils/StaticVector.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+namespace detail {
+
+constexpr auto kBishopAttackOffsets = std::array<matrix::Direction2D, 4>{
+	matrix::Direction2D{.deltaY = -1, .deltaX = -1},
+	matrix::Direction2D{.deltaY = -1, .deltaX = +1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = -1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = +1}};
+
+constexpr auto kRookAttackOffsets = std::array<matrix::Direction2D, 4>{
+	matrix::Direction2D{.deltaY = -1, .deltaX = 0},
+	matrix::Direction2D{.deltaY = 0, .deltaX = -1},
+	matrix::Direction2D{.deltaY = 0, .deltaX = +1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = 0}};
+
+constexpr auto kKnightAttackOffsets = std::array<matrix::Direction2D, 8>{
+	matrix::Direction2D{.deltaY = -2, .deltaX = -1},
+	matrix::Direction2D{.deltaY = -2, .deltaX = +1},
+	matrix::Direction2D{.deltaY = -1, .deltaX = -2},
+	matrix::Direction2D{.deltaY = -1, .deltaX = +2},
+	matrix::Direction2D{.deltaY = +1, .deltaX = -2},
+	matrix::Direction2D{.deltaY = +1, .deltaX = +2},
+	matrix::Direction2D{.deltaY = +2, .deltaX = -1},
+	matrix::Direction2D{.deltaY = +2, .deltaX = +1}};
+
+constexpr auto kKingAttackOffsets = std::array<matrix::Direction2D, 8>{
+	matrix::Direction2D{.deltaY = -1, .deltaX = -1},
+	matrix::Direction2D{.deltaY = -1, .deltaX = 0},
+	matrix::Direction2D{.deltaY = -1, .deltaX = +1},
+	matrix::Direction2D{.deltaY = 0, .deltaX = -1},
+	matrix::Direction2D{.deltaY = 0, .deltaX = +1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = -1},
+	matrix::Direction2D{.deltaY = +1, .deltaX = 0},
+	matrix::Direction2D{.deltaY = +1, .deltaX = +1}};
+
+// Offsets from a square to the squares where a pawn of the given color would be attacking it from.
+[[nodiscard]] constexpr std::array<matrix::Direction2D, 2> PawnAttackerOffsets(const chss::Color pawnColor) {
+	const auto yBackwardOffset = pawnColor == chss::Color::White ? -1 : +1;
+	return std::array<matrix::Direction2D, 2>{
+		matrix::Direction2D{.deltaY = yBackwardOffset, .deltaX = -1},
+		matrix::Direction2D{.deltaY = yBackwardOffset, .deltaX = +1}};
+}
+
+#ifdef CHSS_MAILBOX_BOARD
+
+// Whether the piece is one of the offsets away from the square. The offsets out of the board land on the border of the
+// mailbox, which holds no piece.
+template<std::size_t N>
+[[nodiscard]] constexpr bool IsAtAnyOffset(
+	const chss::Board& board,
+	const chss::Position& square,
+	const std::array<matrix::Direction2D, N>& offsets,
+	const chss::Piece& piece) {
+	for (const auto offset : offsets) {
+		if (board.At(square + offset) == piece) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Whether the square is on the ray from the origin in the direction, the origin excluded.
+[[nodiscard]] constexpr bool IsOnRay(
+	const chss::Position& origin,
+	const matrix::Direction2D& direction,
+	const chss::Position& square) {
+	const auto delta = square - origin;
+	return delta != matrix::Direction2D{.deltaY = 0, .deltaX = 0} &&
+		delta.deltaY * direction.deltaX == delta.deltaX * direction.deltaY && delta.deltaY * direction.deltaY >= 0 &&
+		delta.deltaX * direction.deltaX >= 0;
+}
+
+// A piece that is the only one between a king and a sliding piece that would attack the king without it, and the
+// direction from the king to it.
+struct Pin {
+	chss::Position position;
+	matrix::Direction2D direction;
+};
+
+using Pins = cpp_utils::StaticVector<Pin, 8>;
+
+/**
+ * The pieces of pinnedColor that are the only piece between the king and a sliding piece of sliderColor. With the
+ * colors of a king and its enemy, they are pinned; with the color of the enemy twice, moving them off their ray gives a
+ * discovered check.
+ */
+[[nodiscard]] constexpr Pins FindPins(
+	const chss::Board& board,
+	const chss::Position& kingPosition,
+	const chss::Color pinnedColor,
+	const chss::Color sliderColor) {
+	constexpr auto kSliders = std::array{
+		std::pair(kBishopAttackOffsets, chss::PieceType::Bishop),
+		std::pair(kRookAttackOffsets, chss::PieceType::Rook)};
+	auto pins = Pins();
+	for (const auto& [offsets, sliderType] : kSliders) {
+		for (const auto offset : offsets) {
+			// The border of the mailbox stops the walks.
+			auto position = kingPosition + offset;
+			while (!board.At(position).has_value()) {
+				position += offset;
+			}
+			if (!chss::IsOnBoard(board, position) || board.At(position).value().color != pinnedColor) {
+				continue;
+			}
+			const auto pinnedPosition = position;
+			position += offset;
+			while (!board.At(position).has_value()) {
+				position += offset;
+			}
+			const auto& sliderOpt = board.At(position);
+			if (sliderOpt == chss::Piece{.type = sliderType, .color = sliderColor} ||
+				sliderOpt == chss::Piece{.type = chss::PieceType::Queen, .color = sliderColor}) {
+				pins.PushBack(Pin{.position = pinnedPosition, .direction = offset});
+			}
+		}
+	}
+	return pins;
+}
+
+#else
+
+// The squares of the ray up to its first piece, included.
+template<std::size_t kRayDirectionIndex>
+[[nodiscard]] constexpr chss::Bitboard RayAttacks(const chss::Position& square, const chss::Bitboard occupied) {
+	const auto ray = chss::move_generation::Ray(kRayDirectionIndex, square);
+	const auto pieces = ray & occupied;
+	if (pieces == 0) {
+		return ray;
+	}
+	// The first 4 rays go towards higher square indices.
+	const auto firstPieceIndex = kRayDirectionIndex < 4 ? std::countr_zero(pieces) : 63 - std::countl_zero(pieces);
+	const auto firstPiece = chss::SquarePosition(static_cast<std::size_t>(firstPieceIndex));
+	return ray & ~chss::move_generation::Ray(kRayDirectionIndex, firstPiece);
+}
+
+// Whether the piece is on one of the squares.
+[[nodiscard]] constexpr bool IsOnAnySquare(const chss::Board& board, chss::Bitboard squares, const chss::Piece& piece) {
+	for (; squares != 0; squares &= squares - 1) {
+		if (chss::SquareAt(board, static_cast<std::size_t>(std::countr_zero(squares))) == piece) {
+			return true;
+		}
+	}
+	return false;
+}
+
+#endif
+
+} // namespace detail
+
 namespace chss::move_generation {
 
+// Pawns (2) + knights (8) + first piece of each ray (8) + king (1).
+constexpr std::size_t kMaxAttackers = 2 + 8 + 8 + 1;
+
+using AttackerPositions = cpp_utils::StaticVector<Position, kMaxAttackers>;
+
 [[nodiscard]] constexpr chss::Position FindKing(const chss::Board& board, const chss::Color color) {
-	const auto& boardData = board.GetData();
-	for (std::size_t i = 0; i < boardData.size(); ++i) {
-		const auto pieceOpt = boardData[i];
+	for (std::size_t i = 0; i < 64; ++i) {
+		const auto& pieceOpt = SquareAt(board, i);
 		if (pieceOpt.has_value() && pieceOpt.value() == Piece{.type = PieceType::King, .color = color}) {
 			return chss::Position{.y = static_cast<int>(i / 8), .x = static_cast<int>(i % 8)};
 		}
@@ -16,16 +179,84 @@ namespace chss::move_generation {
 	return chss::Position{.y = -1, .x = -1};
 }
 
-[[nodiscard]] constexpr auto IsInCheck(const Board& board, const Color color, const Position& kingPosition) {
-	const auto enemyColor = InverseColor(color);
-	constexpr auto kBishopOffsets = std::array<matrix::Direction2D, 8>{
-		matrix::Direction2D{.deltaY = -1, .deltaX = -1},
-		matrix::Direction2D{.deltaY = -1, .deltaX = +1},
-		matrix::Direction2D{.deltaY = +1, .deltaX = -1},
-		matrix::Direction2D{.deltaY = +1, .deltaX = +1}};
-	for (const auto offset : kBishopOffsets) {
+#ifndef CHSS_MAILBOX_BOARD
+
+/**
+ * The squares of the pieces, by color and by type.
+ */
+struct PieceBitboards {
+	std::array<Bitboard, 2> byColor;
+	std::array<Bitboard, 6> byType;
+
+	[[nodiscard]] constexpr Bitboard GetOccupied() const {
+		return byColor[0] | byColor[1];
+	}
+
+	[[nodiscard]] constexpr Bitboard Get(const Color color, const PieceType type) const {
+		return byColor[static_cast<std::size_t>(color)] & byType[static_cast<std::size_t>(type)];
+	}
+};
+
+[[nodiscard]] constexpr PieceBitboards ToPieceBitboards(const Board& board) {
+	auto bitboards = PieceBitboards{.byColor = {}, .byType = {}};
+	for (std::size_t i = 0; i < 64; ++i) {
+		const auto& pieceOpt = SquareAt(board, i);
+		if (pieceOpt.has_value()) {
+			bitboards.byColor[static_cast<std::size_t>(pieceOpt.value().color)] |= Bitboard{1} << i;
+			bitboards.byType[static_cast<std::size_t>(pieceOpt.value().type)] |= Bitboard{1} << i;
+		}
+	}
+	return bitboards;
+}
+
+// The squares that a bishop attacks from the square, given the squares of the pieces.
+[[nodiscard]] constexpr Bitboard BishopAttacks(const Position& square, const Bitboard occupied) {
+	return detail::RayAttacks<1>(square, occupied) | detail::RayAttacks<3>(square, occupied) |
+		detail::RayAttacks<5>(square, occupied) | detail::RayAttacks<7>(square, occupied);
+}
+
+// The squares that a rook attacks from the square, given the squares of the pieces.
+[[nodiscard]] constexpr Bitboard RookAttacks(const Position& square, const Bitboard occupied) {
+	return detail::RayAttacks<0>(square, occupied) | detail::RayAttacks<2>(square, occupied) |
+		detail::RayAttacks<4>(square, occupied) | detail::RayAttacks<6>(square, occupied);
+}
+
+/**
+ * Whether a piece of attackerColor attacks the square. Unlike IsInCheck, it does not walk the board: it intersects the
+ * attack tables of the square with the bitboards of the attackers, and only looks for the first piece of the rays that
+ * can hold a sliding attacker.
+ */
+[[nodiscard]] constexpr bool IsSquareAttacked(
+	const PieceBitboards& bitboards,
+	const Position& square,
+	const Color attackerColor) {
+	// The pawns that attack the square are on the squares that a pawn of the other color would attack from it.
+	if ((KnightAttacks(square) & bitboards.Get(attackerColor, PieceType::Knight)) != 0 ||
+		(PawnAttacks(InverseColor(attackerColor), square) & bitboards.Get(attackerColor, PieceType::Pawn)) != 0 ||
+		(KingAttacks(square) & bitboards.Get(attackerColor, PieceType::King)) != 0) {
+		return true;
+	}
+	const auto occupied = bitboards.GetOccupied();
+	const auto queens = bitboards.Get(attackerColor, PieceType::Queen);
+	const auto diagonalAttackers = bitboards.Get(attackerColor, PieceType::Bishop) | queens;
+	// The rays on an empty board tell quickly whether a sliding attacker can be there at all.
+	if ((DiagonalRays(square) & diagonalAttackers) != 0 && (BishopAttacks(square, occupied) & diagonalAttackers) != 0) {
+		return true;
+	}
+	const auto orthogonalAttackers = bitboards.Get(attackerColor, PieceType::Rook) | queens;
+	return (OrthogonalRays(square) & orthogonalAttackers) != 0 &&
+		(RookAttacks(square, occupied) & orthogonalAttackers) != 0;
+}
+
+#endif
+
+// Whether the king of the given color, at the given position, is attacked.
+template<Color kColor>
+[[nodiscard]] constexpr bool IsInCheck(const Board& board, const Position& kingPosition) {
+	constexpr auto enemyColor = InverseColor(kColor);
+	for (const auto offset : detail::kBishopAttackOffsets) {
 		auto to = kingPosition + offset;
-		while (board.IsInside(to)) {
+		while (IsOnBoard(board, to)) {
 			const auto pieceOpt = board.At(to);
 			if (pieceOpt.has_value()) {
 				if (pieceOpt.value().color == enemyColor &&
@@ -37,14 +268,9 @@ namespace chss::move_generation {
 			to += offset;
 		}
 	}
-	constexpr auto kRookOffsets = std::array<matrix::Direction2D, 4>{
-		matrix::Direction2D{.deltaY = -1, .deltaX = 0},
-		matrix::Direction2D{.deltaY = 0, .deltaX = -1},
-		matrix::Direction2D{.deltaY = 0, .deltaX = +1},
-		matrix::Direction2D{.deltaY = +1, .deltaX = 0}};
-	for (const auto offset : kRookOffsets) {
+	for (const auto offset : detail::kRookAttackOffsets) {
 		auto to = kingPosition + offset;
-		while (board.IsInside(to)) {
+		while (IsOnBoard(board, to)) {
 			const auto pieceOpt = board.At(to);
 			if (pieceOpt.has_value()) {
 				if (pieceOpt.value().color == enemyColor &&
@@ -56,49 +282,85 @@ namespace chss::move_generation {
 			to += offset;
 		}
 	}
-	constexpr auto kKnightOffsets = std::array<matrix::Direction2D, 8>{
-		matrix::Direction2D{.deltaY = -2, .deltaX = -1},
-		matrix::Direction2D{.deltaY = -2, .deltaX = +1},
-		matrix::Direction2D{.deltaY = -1, .deltaX = -2},
-		matrix::Direction2D{.deltaY = -1, .deltaX = +2},
-		matrix::Direction2D{.deltaY = +1, .deltaX = -2},
-		matrix::Direction2D{.deltaY = +1, .deltaX = +2},
-		matrix::Direction2D{.deltaY = +2, .deltaX = -1},
-		matrix::Direction2D{.deltaY = +2, .deltaX = +1}};
-	for (const auto offset : kKnightOffsets) {
-		const auto to = kingPosition + offset;
-		if (board.IsInside(to) && board.At(to) == Piece{.type = PieceType::Knight, .color = enemyColor}) {
-			return true;
+	constexpr auto enemyKnight = Piece{.type = PieceType::Knight, .color = enemyColor};
+	constexpr auto enemyPawn = Piece{.type = PieceType::Pawn, .color = enemyColor};
+	constexpr auto enemyKing = Piece{.type = PieceType::King, .color = enemyColor};
+#ifdef CHSS_MAILBOX_BOARD
+	return detail::IsAtAnyOffset(board, kingPosition, detail::kKnightAttackOffsets, enemyKnight) ||
+		detail::IsAtAnyOffset(board, kingPosition, detail::PawnAttackerOffsets(enemyColor), enemyPawn) ||
+		detail::IsAtAnyOffset(board, kingPosition, detail::kKingAttackOffsets, enemyKing);
+#else
+	// The enemy pawns that attack the king are on the squares that a pawn of kColor would attack from the king.
+	return detail::IsOnAnySquare(board, KnightAttacks(kingPosition), enemyKnight) ||
+		detail::IsOnAnySquare(board, PawnAttacks(kColor, kingPosition), enemyPawn) ||
+		detail::IsOnAnySquare(board, KingAttacks(kingPosition), enemyKing);
+#endif
+}
+
+[[nodiscard]] constexpr bool IsInCheck(const Board& board, const Color color, const Position& kingPosition) {
+	if (color == Color::White) {
+		return IsInCheck<Color::White>(board, kingPosition);
+	}
+	return IsInCheck<Color::Black>(board, kingPosition);
+}
+
+/**
+ * Returns the positions of all the pieces of attackerColor that attack the given square.
+ * Only the first piece of each ray is returned: the x-ray attackers behind it show up once it has been removed from
+ * the board (which is what the static exchange evaluation does).
+ */
+[[nodiscard]] constexpr AttackerPositions Attackers(
+	const Board& board,
+	const Position& square,
+	const Color attackerColor) {
+	auto attackers = AttackerPositions();
+	for (const auto offset : detail::PawnAttackerOffsets(attackerColor)) {
+		const auto from = square + offset;
+		if (IsOnBoard(board, from) && board.At(from) == Piece{.type = PieceType::Pawn, .color = attackerColor}) {
+			attackers.PushBack(from);
 		}
 	}
-	const auto kPawnOffsets = [&]() {
-		const auto yForwardOffset = color == Color::White ? +1 : -1;
-		return std::array<matrix::Direction2D, 2>{
-			matrix::Direction2D{.deltaY = yForwardOffset, .deltaX = -1},
-			matrix::Direction2D{.deltaY = yForwardOffset, .deltaX = +1}};
-	}();
-	for (const auto offset : kPawnOffsets) {
-		const auto to = kingPosition + offset;
-		if (board.IsInside(to) && board.At(to) == Piece{.type = PieceType::Pawn, .color = enemyColor}) {
-			return true;
+	for (const auto offset : detail::kKnightAttackOffsets) {
+		const auto from = square + offset;
+		if (IsOnBoard(board, from) && board.At(from) == Piece{.type = PieceType::Knight, .color = attackerColor}) {
+			attackers.PushBack(from);
 		}
 	}
-	constexpr auto kKingOffsets = std::array<matrix::Direction2D, 8>{
-		matrix::Direction2D{.deltaY = -1, .deltaX = -1},
-		matrix::Direction2D{.deltaY = -1, .deltaX = 0},
-		matrix::Direction2D{.deltaY = -1, .deltaX = +1},
-		matrix::Direction2D{.deltaY = 0, .deltaX = -1},
-		matrix::Direction2D{.deltaY = 0, .deltaX = +1},
-		matrix::Direction2D{.deltaY = +1, .deltaX = -1},
-		matrix::Direction2D{.deltaY = +1, .deltaX = 0},
-		matrix::Direction2D{.deltaY = +1, .deltaX = +1}};
-	for (const auto offset : kKingOffsets) {
-		const auto to = kingPosition + offset;
-		if (board.IsInside(to) && board.At(to) == Piece{.type = PieceType::King, .color = enemyColor}) {
-			return true;
+	for (const auto offset : detail::kBishopAttackOffsets) {
+		auto from = square + offset;
+		while (IsOnBoard(board, from)) {
+			const auto pieceOpt = board.At(from);
+			if (pieceOpt.has_value()) {
+				if (pieceOpt.value().color == attackerColor &&
+					(pieceOpt.value().type == PieceType::Bishop || pieceOpt.value().type == PieceType::Queen)) {
+					attackers.PushBack(from);
+				}
+				break;
+			}
+			from += offset;
 		}
 	}
-	return false;
+	for (const auto offset : detail::kRookAttackOffsets) {
+		auto from = square + offset;
+		while (IsOnBoard(board, from)) {
+			const auto pieceOpt = board.At(from);
+			if (pieceOpt.has_value()) {
+				if (pieceOpt.value().color == attackerColor &&
+					(pieceOpt.value().type == PieceType::Rook || pieceOpt.value().type == PieceType::Queen)) {
+					attackers.PushBack(from);
+				}
+				break;
+			}
+			from += offset;
+		}
+	}
+	for (const auto offset : detail::kKingAttackOffsets) {
+		const auto from = square + offset;
+		if (IsOnBoard(board, from) && board.At(from) == Piece{.type = PieceType::King, .color = attackerColor}) {
+			attackers.PushBack(from);
+		}
+	}
+	return attackers;
 }
 
 } // namespace chss::move_generation
@@ -4,6 +4,50 @@
 
 #include <test_utils/TestUtils.h>
 
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+// The boards of the tests of this file.
+constexpr auto kBoards = std::array<std::string_view, 9>{
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR",
+	"8/8/2p5/3K4/8/8/8/8",
+	"8/8/8/3k4/8/2N5/8/8",
+	"8/8/8/3K4/8/8/6b1/8",
+	"8/8/8/3k3R/8/8/8/8",
+	"8/1q6/8/3K4/8/8/8/8",
+	"8/8/4K3/3k4/8/8/8/8",
+	"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3",
+	"8/8/2p1p3/3P4/2P1P3/8/8/8"};
+
+// The mailbox board has no piece bitboards: it only detects attacks by walking the rays (see IsInCheck).
+#ifndef CHSS_MAILBOX_BOARD
+
+// Whether IsSquareAttacked and IsInCheck agree on every square, for both colors.
+[[nodiscard]] constexpr bool IsSquareAttackedIsInCheckOnAllSquares(const std::string_view boardStr) {
+	const auto board = chss::fen::ParseBoard(boardStr);
+	const auto bitboards = chss::move_generation::ToPieceBitboards(board);
+	for (std::size_t i = 0; i < 64; ++i) {
+		const auto square = chss::SquarePosition(i);
+		if (chss::move_generation::IsSquareAttacked(bitboards, square, chss::Color::Black) !=
+				chss::move_generation::IsInCheck(board, chss::Color::White, square) ||
+			chss::move_generation::IsSquareAttacked(bitboards, square, chss::Color::White) !=
+				chss::move_generation::IsInCheck(board, chss::Color::Black, square)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif
+
+} // namespace
+
 TEST_CASE("IsInCheck", "FindKing") {
 	constexpr auto board = chss::fen::ParseBoard("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR");
 	STATIC_REQUIRE(chss::move_generation::FindKing(board, chss::Color::White) == chss::positions::E1);
@@ -45,3 +89,92 @@ TEST_CASE("IsInCheck", "IsInCheck_ByKing") {
 	constexpr auto board = chss::fen::ParseBoard("8/8/4K3/3k4/8/8/8/8");
 	STATIC_REQUIRE(chss::move_generation::IsInCheck(board, chss::Color::Black, chss::positions::D5));
 }
+
+TEST_CASE("IsInCheck", "Attackers") {
+	constexpr auto board = chss::fen::ParseBoard("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3");
+	constexpr auto whiteAttackers = chss::move_generation::Attackers(board, chss::positions::E5, chss::Color::White);
+	STATIC_REQUIRE(whiteAttackers.GetSize() == 2);
+	STATIC_REQUIRE(whiteAttackers[0] == chss::positions::D3);
+	STATIC_REQUIRE(whiteAttackers[1] == chss::positions::E2);
+	constexpr auto blackAttackers = chss::move_generation::Attackers(board, chss::positions::E5, chss::Color::Black);
+	STATIC_REQUIRE(blackAttackers.GetSize() == 2);
+	STATIC_REQUIRE(blackAttackers[0] == chss::positions::D7);
+	STATIC_REQUIRE(blackAttackers[1] == chss::positions::F6);
+}
+
+TEST_CASE("IsInCheck", "Attackers_Pawns") {
+	constexpr auto board = chss::fen::ParseBoard("8/8/2p1p3/3P4/2P1P3/8/8/8");
+	STATIC_REQUIRE(chss::move_generation::Attackers(board, chss::positions::D5, chss::Color::Black).GetSize() == 2);
+	STATIC_REQUIRE(chss::move_generation::Attackers(board, chss::positions::D5, chss::Color::White).GetSize() == 2);
+	STATIC_REQUIRE(chss::move_generation::Attackers(board, chss::positions::D4, chss::Color::White).IsEmpty());
+}
+
+#ifndef CHSS_MAILBOX_BOARD
+
+TEST_CASE("IsInCheck", "ToPieceBitboards") {
+	constexpr auto bitboards =
+		chss::move_generation::ToPieceBitboards(chss::fen::ParseBoard("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"));
+	STATIC_REQUIRE(bitboards.byColor[0] == 0x000000000000FFFFULL);
+	STATIC_REQUIRE(bitboards.byColor[1] == 0xFFFF000000000000ULL);
+	STATIC_REQUIRE(
+		bitboards.Get(chss::Color::White, chss::PieceType::King) == chss::SquareBitboard(chss::positions::E1));
+	STATIC_REQUIRE(bitboards.Get(chss::Color::Black, chss::PieceType::Pawn) == 0x00FF000000000000ULL);
+}
+
+TEST_CASE("IsInCheck", "IsSquareAttacked_SameAsIsInCheck") {
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[0]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[1]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[2]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[3]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[4]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[5]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[6]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[7]));
+	STATIC_REQUIRE(IsSquareAttackedIsInCheckOnAllSquares(kBoards[8]));
+}
+
+// Compares the ray walking of IsInCheck with the bitboard lookups of IsSquareAttacked, on every square of the boards
+// of the tests. The bitboards are computed once per board, as LegalMoves does for all the moves of a position.
+TEST(IsInCheck, DISABLED_IsSquareAttackedSpeed) {
+	constexpr auto kRepetitions = 20000;
+	auto boards = std::array<chss::Board, kBoards.size()>();
+	auto bitboards = std::array<chss::move_generation::PieceBitboards, kBoards.size()>();
+	for (std::size_t i = 0; i < kBoards.size(); ++i) {
+		boards[i] = chss::fen::ParseBoard(kBoards[i]);
+		bitboards[i] = chss::move_generation::ToPieceBitboards(boards[i]);
+	}
+
+	int rayWalkingAttacks = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+		for (const auto& board : boards) {
+			for (std::size_t i = 0; i < 64; ++i) {
+				rayWalkingAttacks +=
+					chss::move_generation::IsInCheck<chss::Color::White>(board, chss::SquarePosition(i));
+			}
+		}
+	}
+	const auto rayWalkingTime = std::chrono::steady_clock::now() - start;
+
+	int bitboardAttacks = 0;
+	start = std::chrono::steady_clock::now();
+	for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+		for (const auto& boardBitboards : bitboards) {
+			for (std::size_t i = 0; i < 64; ++i) {
+				bitboardAttacks += chss::move_generation::IsSquareAttacked(
+					boardBitboards, chss::SquarePosition(i), chss::Color::Black);
+			}
+		}
+	}
+	const auto bitboardTime = std::chrono::steady_clock::now() - start;
+
+	EXPECT_EQ(rayWalkingAttacks, bitboardAttacks);
+	const auto queries = static_cast<std::int64_t>(kRepetitions) * kBoards.size() * 64;
+	std::cout << "queries " << queries << " ray walking "
+			  << std::chrono::duration_cast<std::chrono::nanoseconds>(rayWalkingTime).count() / queries
+			  << "ns/query bitboards "
+			  << std::chrono::duration_cast<std::chrono::nanoseconds>(bitboardTime).count() / queries << "ns/query"
+			  << std::endl;
+}
+
+#endif
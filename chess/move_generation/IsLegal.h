@@ -0,0 +1,209 @@
+#pragma once
+
+#ifndef CHSS_MAILBOX_BOARD
+#include "chess/move_generation/AttackTables.h"
+#endif
+#include "chess/move_generation/IsInCheck.h"
+#include "chess/move_generation/LegalMoves.h"
+#include "chess/move_generation/pieces/KingMoves.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+
+namespace detail {
+
+#ifdef CHSS_MAILBOX_BOARD
+
+// The mailbox board has no attack tables: the geometry of the moves comes from the offsets of the pieces.
+
+[[nodiscard]] constexpr bool IsKingStep(const chss::Move& move) {
+	for (const auto offset : kKingAttackOffsets) {
+		if (move.from + offset == move.to) {
+			return true;
+		}
+	}
+	return false;
+}
+
+[[nodiscard]] constexpr bool IsKnightJump(const chss::Move& move) {
+	for (const auto offset : kKnightAttackOffsets) {
+		if (move.from + offset == move.to) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Whether move.to is on one of the rays from move.from, and the squares between them are empty.
+template<std::size_t N>
+[[nodiscard]] constexpr bool IsOnOpenRay(
+	const chss::Board& board,
+	const chss::Move& move,
+	const std::array<matrix::Direction2D, N>& offsets) {
+	for (const auto offset : offsets) {
+		for (auto position = move.from + offset; chss::IsOnBoard(board, position); position += offset) {
+			if (position == move.to) {
+				return true;
+			}
+			if (board.At(position).has_value()) {
+				break;
+			}
+		}
+	}
+	return false;
+}
+
+[[nodiscard]] constexpr bool IsSlidingPieceMovePseudoLegal(
+	const chss::State& state,
+	const chss::Move& move,
+	const chss::PieceType pieceType) {
+	return (pieceType != chss::PieceType::Rook && IsOnOpenRay(state.board, move, kBishopAttackOffsets)) ||
+		(pieceType != chss::PieceType::Bishop && IsOnOpenRay(state.board, move, kRookAttackOffsets));
+}
+
+#else
+
+[[nodiscard]] constexpr bool IsKingStep(const chss::Move& move) {
+	return (chss::move_generation::KingAttacks(move.from) & chss::SquareBitboard(move.to)) != 0;
+}
+
+[[nodiscard]] constexpr bool IsKnightJump(const chss::Move& move) {
+	return (chss::move_generation::KnightAttacks(move.from) & chss::SquareBitboard(move.to)) != 0;
+}
+
+// Whether all the squares are empty.
+[[nodiscard]] constexpr bool AreSquaresEmpty(const chss::Board& board, chss::Bitboard squares) {
+	for (; squares != 0; squares &= squares - 1) {
+		if (chss::SquareAt(board, static_cast<std::size_t>(std::countr_zero(squares))).has_value()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+[[nodiscard]] constexpr bool IsSlidingPieceMovePseudoLegal(
+	const chss::State& state,
+	const chss::Move& move,
+	const chss::PieceType pieceType) {
+	const auto direction = chss::move_generation::RayDirection(move.from, move.to);
+	const auto isDiagonal = direction.deltaY != 0 && direction.deltaX != 0;
+	const auto isOrthogonal = (direction.deltaY == 0) != (direction.deltaX == 0);
+	auto isDirectionValid = isDiagonal || isOrthogonal;
+	if (pieceType == chss::PieceType::Bishop) {
+		isDirectionValid = isDiagonal;
+	} else if (pieceType == chss::PieceType::Rook) {
+		isDirectionValid = isOrthogonal;
+	}
+	return isDirectionValid && AreSquaresEmpty(state.board, chss::move_generation::Between(move.from, move.to));
+}
+
+#endif
+
+template<chss::Color kColor>
+[[nodiscard]] constexpr bool IsPawnMovePseudoLegal(const chss::State& state, const chss::Move& move) {
+	constexpr int kStartRank = kColor == chss::Color::White ? 1 : 6;
+	constexpr int kForward = kColor == chss::Color::White ? 1 : -1;
+	const auto isPromotionRank = move.to.y == 0 || move.to.y == 7;
+	// A pawn that reaches the last rank has to promote, to a knight, a bishop, a rook or a queen.
+	if (isPromotionRank != move.promotionType.has_value() || move.promotionType == chss::PieceType::Pawn ||
+		move.promotionType == chss::PieceType::King) {
+		return false;
+	}
+	const auto deltaY = move.to.y - move.from.y;
+	const auto deltaX = move.to.x - move.from.x;
+	const auto& target = state.board.At(move.to);
+	if (deltaX == 0) {
+		if (deltaY == kForward) {
+			return !target.has_value();
+		}
+		return deltaY == 2 * kForward && move.from.y == kStartRank && !target.has_value() &&
+			!state.board.At(chss::Position{.y = move.from.y + kForward, .x = move.from.x}).has_value();
+	}
+	return deltaY == kForward && (deltaX == -1 || deltaX == +1) &&
+		((target.has_value() && target.value().color != kColor) || state.enPassantTargetSquare == move.to);
+}
+
+template<chss::Color kColor>
+[[nodiscard]] constexpr bool IsKingMovePseudoLegal(const chss::State& state, const chss::Move& move) {
+	if (IsKingStep(move)) {
+		return true;
+	}
+	// Castling: the generator of the king checks the castling rights and the squares that the king crosses. The
+	// offsets 8 and 9 of kKingMoveOffsets are the ones of castling queen side and king side.
+	constexpr auto kQueenSideCastlingIndex = std::size_t{8};
+	constexpr auto kKingSideCastlingIndex = std::size_t{9};
+	for (const auto castlingIndex : {kQueenSideCastlingIndex, kKingSideCastlingIndex}) {
+		if (move.to == move.from + kKingMoveOffsets[castlingIndex]) {
+			return FindNextKingMoveOffsetIndex<kColor>(state, move.from, castlingIndex) == castlingIndex;
+		}
+	}
+	return false;
+}
+
+} // namespace detail
+
+namespace chss::move_generation {
+
+/**
+ * Whether the move is one of PseudoLegalMoves<kColor>(state), without generating them: for moves that were found in
+ * another position, such as the moves of the transposition table or the killer moves. The move can be any move, even
+ * one with squares out of the board.
+ */
+template<Color kColor>
+[[nodiscard]] constexpr bool IsPseudoLegal(const State& state, const Move& move) {
+	assert(state.activeColor == kColor);
+	if (!state.board.IsInside(move.from) || !state.board.IsInside(move.to)) {
+		return false;
+	}
+	const auto& pieceOpt = state.board.At(move.from);
+	const auto& targetOpt = state.board.At(move.to);
+	if (!pieceOpt.has_value() || pieceOpt.value().color != kColor ||
+		(targetOpt.has_value() && targetOpt.value().color == kColor)) {
+		return false;
+	}
+	const auto pieceType = pieceOpt.value().type;
+	if (pieceType == PieceType::Pawn) {
+		return detail::IsPawnMovePseudoLegal<kColor>(state, move);
+	}
+	if (move.promotionType.has_value()) {
+		return false;
+	}
+	switch (pieceType) {
+	case PieceType::Knight:
+		return detail::IsKnightJump(move);
+	case PieceType::King:
+		return detail::IsKingMovePseudoLegal<kColor>(state, move);
+	default:
+		return detail::IsSlidingPieceMovePseudoLegal(state, move, pieceType);
+	}
+}
+
+[[nodiscard]] constexpr bool IsPseudoLegal(const State& state, const Move& move) {
+	if (state.activeColor == Color::White) {
+		return IsPseudoLegal<Color::White>(state, move);
+	}
+	return IsPseudoLegal<Color::Black>(state, move);
+}
+
+/**
+ * Whether the move is one of LegalMoves<kColor>(state), without generating them (see IsPseudoLegal).
+ */
+template<Color kColor>
+[[nodiscard]] constexpr bool IsLegal(const State& state, const Move& move) {
+	if (!IsPseudoLegal<kColor>(state, move)) {
+		return false;
+	}
+	return detail::IsKingSafeAfterMove<kColor>(state, detail::ComputeKingSafetyInfo<kColor>(state.board), move);
+}
+
+[[nodiscard]] constexpr bool IsLegal(const State& state, const Move& move) {
+	if (state.activeColor == Color::White) {
+		return IsLegal<Color::White>(state, move);
+	}
+	return IsLegal<Color::Black>(state, move);
+}
+
+} // namespace chss::move_generation
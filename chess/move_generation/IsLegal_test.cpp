@@ -0,0 +1,132 @@
+#include "IsLegal.h"
+
+#include "chess/fen/Fen.h"
+#include "chess/move_generation/RandomGames.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+TEST_CASE("IsLegal", "PseudoLegalButLeavesTheKingInCheck") {
+	// The knight on d2 is pinned by the bishop on b4.
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/1b6/8/3N4/4K3 w - - 0 1");
+	constexpr auto move =
+		chss::Move{.from = chss::positions::D2, .to = chss::positions::F3, .promotionType = std::nullopt};
+	STATIC_REQUIRE(chss::move_generation::IsPseudoLegal(state, move));
+	STATIC_REQUIRE(!chss::move_generation::IsLegal(state, move));
+}
+
+TEST_CASE("IsLegal", "BlockedSlidingPiece") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/P7/R3K3 w - - 0 1");
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::A3, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(chss::move_generation::IsLegal(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::D1, .promotionType = std::nullopt}));
+}
+
+TEST_CASE("IsLegal", "Castling") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/R3K2R w Q - 0 1");
+	STATIC_REQUIRE(chss::move_generation::IsLegal(state, chss::Move{.from = chss::positions::E1, .to = chss::positions::C1, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::E1, .to = chss::positions::G1, .promotionType = std::nullopt}));
+}
+
+TEST_CASE("IsLegal", "PromotionType") {
+	constexpr auto state = chss::fen::Parse("8/3P4/8/8/8/8/K6k/8 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::IsLegal(state, chss::Move{.from = chss::positions::D7, .to = chss::positions::D8, .promotionType = chss::PieceType::Knight}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::D7, .to = chss::positions::D8, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::D7, .to = chss::positions::D8, .promotionType = chss::PieceType::King}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::A2, .to = chss::positions::A3, .promotionType = chss::PieceType::Queen}));
+}
+
+TEST_CASE("IsLegal", "EnPassant") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/1Pp5/8/8/4K3 b - b3 0 1");
+	STATIC_REQUIRE(chss::move_generation::IsLegal(state, chss::Move{.from = chss::positions::C4, .to = chss::positions::B3, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::C4, .to = chss::positions::D3, .promotionType = std::nullopt}));
+}
+
+TEST_CASE("IsLegal", "NotAMove") {
+	constexpr auto state = chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::Position{.y = -1, .x = -1}, .to = chss::Position{.y = -1, .x = -1}, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::E7, .to = chss::positions::E5, .promotionType = std::nullopt}));
+	STATIC_REQUIRE(!chss::move_generation::IsPseudoLegal(state, chss::Move{.from = chss::positions::E4, .to = chss::positions::E5, .promotionType = std::nullopt}));
+}
+
+namespace {
+
+template<typename Generator>
+[[nodiscard]] std::vector<chss::Move> ToVector(const Generator& generator) {
+	auto moves = std::vector<chss::Move>();
+	for (const auto move : generator) {
+		moves.push_back(move);
+	}
+	return moves;
+}
+
+[[nodiscard]] bool Contains(const std::vector<chss::Move>& moves, const chss::Move& move) {
+	return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+
+/**
+ * Compares IsPseudoLegal and IsLegal with the generated moves in the positions of random games. The candidate moves
+ * are the pseudo-legal moves of the position, the legal moves of the two previous positions (like the moves of the
+ * transposition table and the killer moves, which come from other positions), and random moves. Returns the number of
+ * compared moves.
+ */
+std::int64_t CompareWithGenerators(const int numPositions) {
+	constexpr auto kRandomMovesPerPosition = 16;
+	auto randomNumberEngine = std::minstd_rand(1070372);
+	auto squareDistribution = std::uniform_int_distribution<int>(0, 7);
+	// 0 for no promotion, otherwise the piece type + 1 (including the invalid promotions to a pawn or a king).
+	auto promotionDistribution = std::uniform_int_distribution<int>(0, 6);
+
+	std::int64_t numComparedMoves = 0;
+	auto previousMoves = std::array<std::vector<chss::Move>, 2>();
+	chss::move_generation::ForEachRandomGamePosition(
+		numPositions,
+		[&](const chss::State& state, const std::vector<chss::Move>& legalMoves) {
+			const auto pseudoLegalMoves = ToVector(chss::move_generation::PseudoLegalMoves(state));
+
+			auto candidates = pseudoLegalMoves;
+			candidates.insert(candidates.end(), previousMoves[0].begin(), previousMoves[0].end());
+			candidates.insert(candidates.end(), previousMoves[1].begin(), previousMoves[1].end());
+			for (int j = 0; j < kRandomMovesPerPosition; ++j) {
+				const auto fromY = squareDistribution(randomNumberEngine);
+				const auto fromX = squareDistribution(randomNumberEngine);
+				const auto toY = squareDistribution(randomNumberEngine);
+				const auto toX = squareDistribution(randomNumberEngine);
+				const auto promotion = promotionDistribution(randomNumberEngine);
+				candidates.push_back(chss::Move{
+					.from = chss::Position{.y = fromY, .x = fromX},
+					.to = chss::Position{.y = toY, .x = toX},
+					.promotionType =
+						promotion == 0 ? std::nullopt : std::optional(static_cast<chss::PieceType>(promotion - 1))});
+			}
+			for (const auto& move : candidates) {
+				EXPECT_EQ(chss::move_generation::IsPseudoLegal(state, move), Contains(pseudoLegalMoves, move))
+					<< chss::fen::Serialize(state) << " " << move.from.y << move.from.x << move.to.y << move.to.x;
+				EXPECT_EQ(chss::move_generation::IsLegal(state, move), Contains(legalMoves, move))
+					<< chss::fen::Serialize(state) << " " << move.from.y << move.from.x << move.to.y << move.to.x;
+			}
+			numComparedMoves += static_cast<std::int64_t>(candidates.size());
+
+			previousMoves[1] = std::move(previousMoves[0]);
+			previousMoves[0] = legalMoves;
+		});
+	return numComparedMoves;
+}
+
+} // namespace
+
+TEST(IsLegal, SameAsTheGenerators) {
+	EXPECT_GT(CompareWithGenerators(5000), 5000);
+}
+
+TEST(IsLegal, DISABLED_SameAsTheGeneratorsOnMillionsOfPositions) {
+	EXPECT_GT(CompareWithGenerators(2000000), 2000000);
+}
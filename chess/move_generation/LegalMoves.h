@@ -1,23 +1,126 @@
 #pragma once
 
+#include "chess/move_generation/ActiveColorGenerator.h"
 #include "chess/move_generation/IsInCheck.h"
 #include "chess/move_generation/MakeMove.h"
 #include "chess/move_generation/PseudoLegalMoves.h"
 
+#include <bit>
+#include <cstddef>
+
 namespace detail {
 
-constexpr void FindNextLegalMove(const chss::State& state, auto& it, const auto& end) {
-	while (it != end) {
-		auto move = *it;
+#ifdef CHSS_MAILBOX_BOARD
+
+/**
+ * What IsKingSafeAfterMove needs to know about the position before the moves, computed once for all of them. The
+ * mailbox board has no attack tables: the pins are found by walking the rays from the king.
+ */
+struct KingSafetyInfo {
+	chss::Position kingPosition;
+	bool isInCheck;
+	Pins pins;
+};
+
+template<chss::Color kColor>
+[[nodiscard]] constexpr KingSafetyInfo ComputeKingSafetyInfo(const chss::Board& board) {
+	const auto kingPosition = chss::move_generation::FindKing(board, kColor);
+	return KingSafetyInfo{
+		.kingPosition = kingPosition,
+		.isInCheck = chss::move_generation::IsInCheck<kColor>(board, kingPosition),
+		.pins = FindPins(board, kingPosition, kColor, chss::InverseColor(kColor))};
+}
+
+/**
+ * Whether the pseudo-legal move of kColor leaves its king out of check. A pinned piece can only move along its pin,
+ * and the other pieces can move freely. The moves of the king, the en passant captures (which empty
+ * two squares) and the moves out of check are played instead, and the rays are walked from the king (see IsInCheck).
+ */
+template<chss::Color kColor>
+[[nodiscard]] constexpr bool IsKingSafeAfterMove(
+	const chss::State& state,
+	const KingSafetyInfo& kingSafetyInfo,
+	const chss::Move& move) {
+	const auto kingPosition = kingSafetyInfo.kingPosition;
+	if (kingSafetyInfo.isInCheck || move.from == kingPosition ||
+		chss::move_generation::GetMoveKind(state, move) == chss::move_generation::MoveKind::EnPassant) {
+		const auto newKingPosition = move.from == kingPosition ? move.to : kingPosition;
 		const auto newState = chss::move_generation::MakeMove(state, move);
-		const auto kingPosition = chss::move_generation::FindKing(newState.board, state.activeColor);
-		if (!chss::move_generation::IsInCheck(newState.board, state.activeColor, kingPosition)) {
-			return;
+		return !chss::move_generation::IsInCheck<kColor>(newState.board, newKingPosition);
+	}
+	for (const auto& pin : kingSafetyInfo.pins) {
+		if (pin.position == move.from) {
+			return IsOnRay(kingPosition, pin.direction, move.to);
 		}
+	}
+	return true;
+}
+
+#else
+
+/**
+ * What IsKingSafeAfterMove needs to know about the position before the moves, computed once for all of them.
+ */
+struct KingSafetyInfo {
+	chss::move_generation::PieceBitboards bitboards;
+	chss::Position kingPosition;
+};
+
+template<chss::Color kColor>
+[[nodiscard]] constexpr KingSafetyInfo ComputeKingSafetyInfo(const chss::Board& board) {
+	const auto bitboards = chss::move_generation::ToPieceBitboards(board);
+	return KingSafetyInfo{
+		.bitboards = bitboards,
+		.kingPosition = chss::SquarePosition(
+			static_cast<std::size_t>(std::countr_zero(bitboards.Get(kColor, chss::PieceType::King))))};
+}
+
+/**
+ * Whether the pseudo-legal move of kColor leaves its king out of check. It does not play the move on the board: it only
+ * moves the pieces in the color bitboards, which is all that IsSquareAttacked needs to find the enemy attackers (the
+ * type bitboards still have the moved piece on move.from, but it is not an enemy).
+ */
+template<chss::Color kColor>
+[[nodiscard]] constexpr bool IsKingSafeAfterMove(
+	const chss::State& state,
+	const KingSafetyInfo& kingSafetyInfo,
+	const chss::Move& move) {
+	auto newBitboards = kingSafetyInfo.bitboards;
+	auto& ownPieces = newBitboards.byColor[static_cast<std::size_t>(kColor)];
+	auto& enemyPieces = newBitboards.byColor[static_cast<std::size_t>(chss::InverseColor(kColor))];
+	ownPieces ^= chss::SquareBitboard(move.from) | chss::SquareBitboard(move.to);
+	enemyPieces &= ~chss::SquareBitboard(move.to);
+	switch (chss::move_generation::GetMoveKind(state, move)) {
+	case chss::move_generation::MoveKind::EnPassant:
+		enemyPieces &= ~chss::SquareBitboard(chss::Position{.y = move.from.y, .x = move.to.x});
+		break;
+	case chss::move_generation::MoveKind::Castling: {
+		const auto rookMove = chss::move_generation::CastlingRookMove<kColor>(move);
+		ownPieces ^= chss::SquareBitboard(rookMove.from) | chss::SquareBitboard(rookMove.to);
+		break;
+	}
+	default:
+		break;
+	}
+	const auto kingPosition = kingSafetyInfo.kingPosition;
+	const auto newKingPosition = move.from == kingPosition ? move.to : kingPosition;
+	return !chss::move_generation::IsSquareAttacked(newBitboards, newKingPosition, chss::InverseColor(kColor));
+}
+
+#endif
+
+template<chss::Color kColor>
+constexpr void FindNextLegalMove(
+	const chss::State& state,
+	const KingSafetyInfo& kingSafetyInfo,
+	auto& it,
+	const auto& end) {
+	while (it != end && !IsKingSafeAfterMove<kColor>(state, kingSafetyInfo, *it)) {
 		++it;
 	}
 }
 
+template<chss::Color kColor>
 class LegalMovesGenerator {
 public:
 	class Sentinel {};
@@ -26,9 +129,10 @@ public:
 	public:
 		constexpr explicit Iterator(const chss::State& state)
 			: mState(state)
-			, mPseudoLegalMovesIt(chss::move_generation::PseudoLegalMoves(state).begin())
-			, mPseudoLegalMovesEnd(chss::move_generation::PseudoLegalMoves(state).end()) {
-			FindNextLegalMove(state, mPseudoLegalMovesIt, mPseudoLegalMovesEnd);
+			, mPseudoLegalMovesIt(chss::move_generation::PseudoLegalMoves<kColor>(state).begin())
+			, mPseudoLegalMovesEnd(chss::move_generation::PseudoLegalMoves<kColor>(state).end())
+			, mKingSafetyInfo(ComputeKingSafetyInfo<kColor>(state.board)) {
+			FindNextLegalMove<kColor>(state, mKingSafetyInfo, mPseudoLegalMovesIt, mPseudoLegalMovesEnd);
 		}
 
 		[[nodiscard]] constexpr chss::Move operator*() const {
@@ -39,7 +143,7 @@ public:
 		constexpr Iterator& operator++() {
 			assert(mPseudoLegalMovesIt != mPseudoLegalMovesEnd);
 			++mPseudoLegalMovesIt;
-			FindNextLegalMove(mState, mPseudoLegalMovesIt, mPseudoLegalMovesEnd);
+			FindNextLegalMove<kColor>(mState, mKingSafetyInfo, mPseudoLegalMovesIt, mPseudoLegalMovesEnd);
 			return *this;
 		}
 
@@ -53,12 +157,15 @@ public:
 
 	private:
 		chss::State mState;
-		decltype(chss::move_generation::PseudoLegalMoves(std::declval<chss::State>()).begin()) mPseudoLegalMovesIt;
-		decltype(chss::move_generation::PseudoLegalMoves(std::declval<chss::State>()).end()) mPseudoLegalMovesEnd;
+		typename PseudoLegalMovesGenerator<kColor>::Iterator mPseudoLegalMovesIt;
+		typename PseudoLegalMovesGenerator<kColor>::Sentinel mPseudoLegalMovesEnd;
+		KingSafetyInfo mKingSafetyInfo;
 	};
 
 	constexpr explicit LegalMovesGenerator(const chss::State& state)
-		: mState(state) {}
+		: mState(state) {
+		assert(state.activeColor == kColor);
+	}
 
 	[[nodiscard]] constexpr Iterator begin() const {
 		return Iterator(mState);
@@ -77,7 +184,13 @@ private:
 namespace chss::move_generation {
 
 [[nodiscard]] constexpr auto LegalMoves(const State& state) {
-	return detail::LegalMovesGenerator(state);
+	return detail::ActiveColorGenerator<detail::LegalMovesGenerator>(state);
+}
+
+// For the active color kColor.
+template<Color kColor>
+[[nodiscard]] constexpr auto LegalMoves(const State& state) {
+	return detail::LegalMovesGenerator<kColor>(state);
 }
 
 } // namespace chss::move_generation
@@ -3,63 +3,143 @@
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
 
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace detail {
+
+// Castling rights that remain after a move from or to each square. A move from or to a corner of a back rank moves or
+// captures the rook of that corner, and a move from the initial square of a king moves the king.
+constexpr auto kCastlingRightsMasks = [] {
+	auto masks = std::array<chss::CastlingRights, 64>();
+	masks.fill(chss::CastlingRights::All);
+	masks[chss::SquareIndex(chss::positions::A1)] = ~chss::CastlingRights::WhiteQueenSide;
+	masks[chss::SquareIndex(chss::positions::H1)] = ~chss::CastlingRights::WhiteKingSide;
+	masks[chss::SquareIndex(chss::positions::E1)] =
+		~(chss::CastlingRights::WhiteKingSide | chss::CastlingRights::WhiteQueenSide);
+	masks[chss::SquareIndex(chss::positions::A8)] = ~chss::CastlingRights::BlackQueenSide;
+	masks[chss::SquareIndex(chss::positions::H8)] = ~chss::CastlingRights::BlackKingSide;
+	masks[chss::SquareIndex(chss::positions::E8)] =
+		~(chss::CastlingRights::BlackKingSide | chss::CastlingRights::BlackQueenSide);
+	return masks;
+}();
+
+} // namespace detail
+
 namespace chss::move_generation {
 
+/**
+ * What a move does on top of moving a piece from move.from to move.to.
+ */
+enum class MoveKind : std::uint8_t {
+	Normal,
+	// Sets the en passant target square.
+	PawnDoubleAdvance,
+	// Captures the pawn next to move.from instead of a piece on move.to.
+	EnPassant,
+	Promotion,
+	// Moves the rook too.
+	Castling,
+};
+
+/**
+ * The kind of a pseudo-legal move of the active color.
+ */
+[[nodiscard]] constexpr MoveKind GetMoveKind(const State& state, const Move& move) {
+	switch (state.board.At(move.from).value().type) {
+	case PieceType::Pawn:
+		if (move.promotionType.has_value()) {
+			return MoveKind::Promotion;
+		}
+		if (move.to == state.enPassantTargetSquare) {
+			return MoveKind::EnPassant;
+		}
+		if (move.to.y - move.from.y == 2 || move.to.y - move.from.y == -2) {
+			return MoveKind::PawnDoubleAdvance;
+		}
+		return MoveKind::Normal;
+	case PieceType::King:
+		return move.to.x - move.from.x == 2 || move.to.x - move.from.x == -2 ? MoveKind::Castling : MoveKind::Normal;
+	default:
+		return MoveKind::Normal;
+	}
+}
+
+/**
+ * The move of the rook that goes with a castling move of the king of kColor: from its corner to the other side of the
+ * king.
+ */
+template<Color kColor>
+[[nodiscard]] constexpr Move CastlingRookMove(const Move& kingMove) {
+	constexpr int kBackRank = kColor == Color::White ? 0 : 7;
+	const auto isKingSide = kingMove.to.x > kingMove.from.x;
+	return Move{
+		.from = Position{.y = kBackRank, .x = isKingSide ? 7 : 0},
+		.to = Position{.y = kBackRank, .x = isKingSide ? 5 : 3},
+		.promotionType = std::nullopt};
+}
+
+/**
+ * Plays the move for the active color kColor. The move has to be pseudo-legal.
+ */
+template<Color kColor>
 [[nodiscard]] constexpr State MakeMove(const State& state, const Move& move) {
+	assert(state.activeColor == kColor);
+	constexpr int kForward = kColor == Color::White ? 1 : -1;
+	const auto& piece = state.board.At(move.from).value();
 	auto newState = state;
 
-	newState.activeColor = InverseColor(state.activeColor);
-	newState.board.At(move.to) = newState.board.At(move.from);
+	newState.activeColor = InverseColor(kColor);
+	newState.board.At(move.to) = piece;
 	newState.board.At(move.from) = std::nullopt;
+	newState.castlingRights &= detail::kCastlingRightsMasks[SquareIndex(move.from)] &
+		detail::kCastlingRightsMasks[SquareIndex(move.to)];
 	newState.enPassantTargetSquare = std::nullopt;
 	newState.fullmoveNumber = state.fullmoveNumber + 1;
+	// Pawn moves and captures are irreversible: no earlier position can be repeated after them.
+	const auto isIrreversible = piece.type == PieceType::Pawn || state.board.At(move.to).has_value();
+	newState.halfmoveClock = isIrreversible ? 0 : state.halfmoveClock + 1;
 
-	if (move.promotionType.has_value()) {
-		newState.board.At(move.to) = Piece{.type = move.promotionType.value(), .color = state.activeColor};
-	} else if (move.from == Position{.y = 0, .x = 0}) {
-		newState.castlingAvailabilities.white.isQueenSideAvailable = false;
-	} else if (move.from == Position{.y = 0, .x = 7}) {
-		newState.castlingAvailabilities.white.isKingSideAvailable = false;
-	} else if (move.from == Position{.y = 7, .x = 0}) {
-		newState.castlingAvailabilities.black.isQueenSideAvailable = false;
-	} else if (move.from == Position{.y = 7, .x = 7}) {
-		newState.castlingAvailabilities.black.isKingSideAvailable = false;
-	} else if (move.from == Position{.y = 0, .x = 4} && state.board.At(move.from).value().type == PieceType::King) {
-		newState.castlingAvailabilities.white = CastlingAvailability{.isKingSideAvailable = false, .isQueenSideAvailable = false};
-		if (move.to == Position{.y = 0, .x = 2}) {
-			newState.board.At(Position{.y = 0, .x = 3}) = newState.board.At(Position{.y = 0, .x = 0});
-			newState.board.At(Position{.y = 0, .x = 0}) = std::nullopt;
-		} else if (move.to == Position{.y = 0, .x = 6}) {
-			newState.board.At(Position{.y = 0, .x = 5}) = newState.board.At(Position{.y = 0, .x = 7});
-			newState.board.At(Position{.y = 0, .x = 7}) = std::nullopt;
-		}
-	} else if (move.from == Position{.y = 7, .x = 4} && state.board.At(move.from).value().type == PieceType::King) {
-		newState.castlingAvailabilities.black = CastlingAvailability{.isKingSideAvailable = false, .isQueenSideAvailable = false};
-		if (move.to == Position{.y = 7, .x = 2}) {
-			newState.board.At(Position{.y = 7, .x = 3}) = newState.board.At(Position{.y = 7, .x = 0});
-			newState.board.At(Position{.y = 7, .x = 0}) = std::nullopt;
-		} else if (move.to == Position{.y = 7, .x = 6}) {
-			newState.board.At(Position{.y = 7, .x = 5}) = newState.board.At(Position{.y = 7, .x = 7});
-			newState.board.At(Position{.y = 7, .x = 7}) = std::nullopt;
-		}
-	} else if (move.from.y == 1 && move.to.y == 3 && state.board.At(move.from).value().type == PieceType::Pawn) {
-		newState.enPassantTargetSquare = Position{.y = 2, .x = move.from.x};
-	} else if (move.from.y == 6 && move.to.y == 4 && state.board.At(move.from).value().type == PieceType::Pawn) {
-		newState.enPassantTargetSquare = Position{.y = 5, .x = move.from.x};
+	switch (GetMoveKind(state, move)) {
+	case MoveKind::Normal:
+		break;
+	case MoveKind::PawnDoubleAdvance:
+		newState.enPassantTargetSquare = Position{.y = move.from.y + kForward, .x = move.from.x};
+		break;
+	case MoveKind::EnPassant:
+		newState.board.At(Position{.y = move.from.y, .x = move.to.x}) = std::nullopt;
+		break;
+	case MoveKind::Promotion:
+		newState.board.At(move.to) = Piece{.type = move.promotionType.value(), .color = kColor};
+		break;
+	case MoveKind::Castling: {
+		const auto rookMove = CastlingRookMove<kColor>(move);
+		newState.board.At(rookMove.to) = newState.board.At(rookMove.from);
+		newState.board.At(rookMove.from) = std::nullopt;
+		break;
+	}
 	}
 
-	if (move.to == Position{.y = 0, .x = 0}) {
-		newState.castlingAvailabilities.white.isQueenSideAvailable = false;
-	} else if (move.to == Position{.y = 0, .x = 7}) {
-		newState.castlingAvailabilities.white.isKingSideAvailable = false;
-	} else if (move.to == Position{.y = 7, .x = 0}) {
-		newState.castlingAvailabilities.black.isQueenSideAvailable = false;
-	} else if (move.to == Position{.y = 7, .x = 7}) {
-		newState.castlingAvailabilities.black.isKingSideAvailable = false;
-	} else if (move.to == state.enPassantTargetSquare && state.board.At(move.from).value().type == PieceType::Pawn) {
-		newState.board.At(Position{.y = move.from.y, .x = move.to.x}) = std::nullopt;
+	return newState;
+}
+
+[[nodiscard]] constexpr State MakeMove(const State& state, const Move& move) {
+	if (state.activeColor == Color::White) {
+		return MakeMove<Color::White>(state, move);
 	}
+	return MakeMove<Color::Black>(state, move);
+}
 
+/**
+ * Passes the turn to the opponent without moving. Only the search uses it (null-move pruning); it is never legal.
+ */
+[[nodiscard]] constexpr State MakeNullMove(const State& state) {
+	auto newState = state;
+	newState.activeColor = InverseColor(state.activeColor);
+	newState.enPassantTargetSquare = std::nullopt;
+	newState.fullmoveNumber = state.fullmoveNumber + 1;
+	newState.halfmoveClock = state.halfmoveClock + 1;
 	return newState;
 }
 
@@ -16,28 +16,28 @@ TEST_CASE("MakeMove", "Promotion") {
 TEST_CASE("MakeMove", "MoveRook_WiteQueenSide_QueenSideCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/R3K3 w Q - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::A5, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/R7/8/8/8/4K3 b - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/R7/8/8/8/4K3 b - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "MoveRook_WiteKingSide_KingSideCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/4K2R w K - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::H1, .to = chss::positions::H5, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/7R/8/8/8/4K3 b - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/7R/8/8/8/4K3 b - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "MoveRook_BlackQueenSide_QueenSideCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("r3k3/8/8/8/8/8/8/4K3 b q - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::A8, .to = chss::positions::A4, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/r7/8/8/4K3 w - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/r7/8/8/4K3 w - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "MoveRook_BlackKingSide_KingSideCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("4k2r/8/8/8/8/8/8/4K3 b - - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::H8, .to = chss::positions::H4, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/7r/8/8/4K3 w - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/7r/8/8/4K3 w - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
@@ -45,14 +45,14 @@ TEST_CASE("MakeMove", "MoveRook_BlackKingSide_KingSideCastlingNoLongerAvailable"
 TEST_CASE("MakeMove", "MoveKing_White_CastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/R3K2R w KQ - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::E1, .to = chss::positions::E2, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/8/8/4K3/R6R b - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/8/8/4K3/R6R b - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "MoveKing_Black_CastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("r3k2r/8/8/8/8/8/8/4K3 b kq - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::E8, .to = chss::positions::E7, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("r6r/4k3/8/8/8/8/8/4K3 w - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("r6r/4k3/8/8/8/8/8/4K3 w - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
@@ -60,28 +60,28 @@ TEST_CASE("MakeMove", "MoveKing_Black_CastlingNoLongerAvailable") {
 TEST_CASE("MakeMove", "Castling_WhiteQueenSide_RookMovesAndCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/R3K2R w KQ - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::E1, .to = chss::positions::C1, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/8/8/8/2KR3R b - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/8/8/8/2KR3R b - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "Castling_WhiteKingSide_RookMovesAndCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/R3K2R w KQ - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::E1, .to = chss::positions::G1, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/8/8/8/R4RK1 b - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/8/8/8/R4RK1 b - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "Castling_BlackQueenSide_RookMovesAndCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("r3k2r/8/8/8/8/8/8/4K3 b kq - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::E8, .to = chss::positions::C8, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("2kr3r/8/8/8/8/8/8/4K3 w - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("2kr3r/8/8/8/8/8/8/4K3 w - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
 TEST_CASE("MakeMove", "Castling_BlackKingSide_RookMovesAndCastlingNoLongerAvailable") {
 	constexpr auto state = chss::fen::Parse("r3k2r/8/8/8/8/8/8/4K3 b kq - 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::E8, .to = chss::positions::G8, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("r4rk1/8/8/8/8/8/8/4K3 w - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("r4rk1/8/8/8/8/8/8/4K3 w - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
@@ -129,6 +129,21 @@ TEST_CASE("MakeMove", "EatRook_WhiteEatsKingSide_CastlingNoLongerAvailable") {
 	STATIC_REQUIRE(result == expectedResult);
 }
 
+// Captures between rooks and promotions on the corners, castling no longer available for either side (2)
+TEST_CASE("MakeMove", "EatRook_WithRook_BothSidesLoseCastling") {
+	constexpr auto state = chss::fen::Parse("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::A8, .promotionType = std::nullopt});
+	constexpr auto expectedResult = chss::fen::Parse("R3k2r/8/8/8/8/8/8/4K2R b Kk - 0 2");
+	STATIC_REQUIRE(result == expectedResult);
+}
+
+TEST_CASE("MakeMove", "PromotionEatsRook_CastlingNoLongerAvailable") {
+	constexpr auto state = chss::fen::Parse("4k2r/6P1/8/8/8/8/8/4K3 w k - 0 1");
+	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::G7, .to = chss::positions::H8, .promotionType = chss::PieceType::Knight});
+	constexpr auto expectedResult = chss::fen::Parse("4k2N/8/8/8/8/8/8/4K3 b - - 0 2");
+	STATIC_REQUIRE(result == expectedResult);
+}
+
 // Eat en passant with a pawn (1)
 TEST_CASE("MakeMove", "EatEnPassant_EatenPawnDisappears") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/8/1Pp5/8/8/4K3 b - b3 0 1");
@@ -141,7 +156,7 @@ TEST_CASE("MakeMove", "EatEnPassant_EatenPawnDisappears") {
 TEST_CASE("MakeMove", "MoveToEnPassantTargetSquare_BlackBishop_DoNotEatPawn") {
 	constexpr auto state = chss::fen::Parse("4k3/8/8/3b4/1P6/8/8/4K3 b - b3 0 1");
 	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::D5, .to = chss::positions::B3, .promotionType = std::nullopt});
-	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/1P6/1b6/8/4K3 w - - 0 2");
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/1P6/1b6/8/4K3 w - - 1 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
 
@@ -152,3 +167,59 @@ TEST_CASE("MakeMove", "MoveWhilePassantTargetSquare_EnPassantOpportunityLost") {
 	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/8/1P3p2/8/8/4K3 w - - 0 2");
 	STATIC_REQUIRE(result == expectedResult);
 }
+
+// Null move (1)
+TEST_CASE("MakeMove", "NullMove_FlipsActiveColorAndClearsEnPassantTargetSquare") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/5p2/1P6/8/8/4K3 b - b3 0 1");
+	constexpr auto result = chss::move_generation::MakeNullMove(state);
+	constexpr auto expectedResult = chss::fen::Parse("4k3/8/8/5p2/1P6/8/8/4K3 w - - 1 2");
+	STATIC_REQUIRE(result == expectedResult);
+}
+
+// Halfmove clock (3)
+TEST_CASE("MakeMove", "HalfmoveClock_QuietPieceMove_Increments") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/8/R3K3 w - - 7 20");
+	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::A5, .promotionType = std::nullopt});
+	STATIC_REQUIRE(result.halfmoveClock == 8);
+}
+
+TEST_CASE("MakeMove", "HalfmoveClock_PawnMove_Resets") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/2P5/4K3 w - - 7 20");
+	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::C2, .to = chss::positions::C3, .promotionType = std::nullopt});
+	STATIC_REQUIRE(result.halfmoveClock == 0);
+}
+
+TEST_CASE("MakeMove", "HalfmoveClock_Capture_Resets") {
+	constexpr auto state = chss::fen::Parse("4k3/8/5b2/8/8/8/8/R3K2R b KQ - 7 20");
+	constexpr auto result = chss::move_generation::MakeMove(state, chss::Move{.from = chss::positions::F6, .to = chss::positions::A1, .promotionType = std::nullopt});
+	STATIC_REQUIRE(result.halfmoveClock == 0);
+}
+
+// Move kinds (5)
+TEST_CASE("MakeMove", "MoveKind_Normal") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/8/8/2P5/R3K3 w Q - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::C2, .to = chss::positions::C3, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::Normal);
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::E1, .to = chss::positions::D1, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::Normal);
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::A1, .to = chss::positions::C1, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::Normal);
+}
+
+TEST_CASE("MakeMove", "MoveKind_PawnDoubleAdvance") {
+	constexpr auto state = chss::fen::Parse("4k3/2p5/8/8/8/8/8/4K3 b - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::C7, .to = chss::positions::C5, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::PawnDoubleAdvance);
+}
+
+TEST_CASE("MakeMove", "MoveKind_EnPassant") {
+	constexpr auto state = chss::fen::Parse("4k3/8/8/8/1Pp5/8/8/4K3 b - b3 0 1");
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::C4, .to = chss::positions::B3, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::EnPassant);
+}
+
+TEST_CASE("MakeMove", "MoveKind_Promotion") {
+	constexpr auto state = chss::fen::Parse("8/3P4/8/8/8/8/K6k/8 w - - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::D7, .to = chss::positions::D8, .promotionType = chss::PieceType::Rook}) == chss::move_generation::MoveKind::Promotion);
+}
+
+TEST_CASE("MakeMove", "MoveKind_Castling") {
+	constexpr auto state = chss::fen::Parse("r3k2r/8/8/8/8/8/8/4K3 b kq - 0 1");
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::E8, .to = chss::positions::C8, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::Castling);
+	STATIC_REQUIRE(chss::move_generation::GetMoveKind(state, chss::Move{.from = chss::positions::E8, .to = chss::positions::G8, .promotionType = std::nullopt}) == chss::move_generation::MoveKind::Castling);
+}
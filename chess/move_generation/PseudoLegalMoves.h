@@ -1,5 +1,6 @@
 #pragma once
 
+#include "chess/move_generation/ActiveColorGenerator.h"
 #include "chess/move_generation/pieces/KingMoves.h"
 #include "chess/move_generation/pieces/KnightMoves.h"
 #include "chess/move_generation/pieces/PawnMoves.h"
@@ -7,282 +8,110 @@
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
 
-namespace detail {
-
-struct PawnState {
-	using Iterator = decltype(chss::move_generation::PawnPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .begin());
-	using Sentinel = decltype(chss::move_generation::PawnPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .end());
-	Iterator it;
-	Sentinel end;
-};
+#include <optional>
+#include <utility>
+#include <variant>
 
-struct KnightState {
-	using Iterator = decltype(chss::move_generation::KnightPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .begin());
-	using Sentinel = decltype(chss::move_generation::KnightPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .end());
-	Iterator it;
-	Sentinel end;
-};
-
-struct BishopState {
-	using Iterator = decltype(chss::move_generation::BishopPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .begin());
-	using Sentinel = decltype(chss::move_generation::BishopPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .end());
-	Iterator it;
-	Sentinel end;
-};
-
-struct RookState {
-	using Iterator = decltype(chss::move_generation::RookPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .begin());
-	using Sentinel = decltype(chss::move_generation::RookPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .end());
-	Iterator it;
-	Sentinel end;
-};
-
-struct QueenState {
-	using Iterator = decltype(chss::move_generation::QueenPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .begin());
-	using Sentinel = decltype(chss::move_generation::QueenPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .end());
-	Iterator it;
-	Sentinel end;
-};
+namespace detail {
 
-struct KingState {
-	using Iterator = decltype(chss::move_generation::KingPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .begin());
-	using Sentinel = decltype(chss::move_generation::KingPseudoLegalMoves(
-								  std::declval<chss::State>(),
-								  std::declval<chss::Position>())
-								  .end());
-	Iterator it;
-	Sentinel end;
+template<typename Generator>
+struct PieceMovesState {
+	typename Generator::Iterator it;
+	typename Generator::Sentinel end;
 };
 
-using PieceState = std::variant<PawnState, KnightState, BishopState, RookState, QueenState, KingState>;
+template<chss::Color kColor>
+using PieceState = std::variant<
+	PieceMovesState<PawnMovesGenerator<kColor>>,
+	PieceMovesState<KnightMovesGenerator<kColor>>,
+	PieceMovesState<BishopMovesGenerator<kColor>>,
+	PieceMovesState<RookMovesGenerator<kColor>>,
+	PieceMovesState<QueenMovesGenerator<kColor>>,
+	PieceMovesState<KingMovesGenerator<kColor>>>;
 
+template<chss::Color kColor>
 struct MovePositionAndPieceState {
 	chss::Position position;
-	PieceState pieceState;
+	PieceState<kColor> pieceState;
 };
 
-[[nodiscard]] constexpr MovePositionAndPieceState FindFirstMove(const chss::State& state) {
-	int y = 0;
-	int x = 0;
-	while (y < state.board.GetSize().sizeY) {
-		while (x < state.board.GetSize().sizeX) {
-			const auto position = chss::Position{.y = y, .x = x};
-			const auto& pieceOpt = state.board.At(position);
-			if (pieceOpt.has_value() && pieceOpt.value().color == state.activeColor) {
-				switch (pieceOpt.value().type) {
-				case chss::PieceType::Pawn: {
-					const auto pawnGenerator = chss::move_generation::PawnPseudoLegalMoves(state, position);
-					auto it = pawnGenerator.begin();
-					auto end = pawnGenerator.end();
-					if (it != end) {
-						return MovePositionAndPieceState{
-							.position = position,
-							.pieceState = PawnState{.it = std::move(it), .end = std::move(end)}};
-					}
-					break;
-				}
-				case chss::PieceType::Knight: {
-					const auto knightGenerator = chss::move_generation::KnightPseudoLegalMoves(state, position);
-					auto it = knightGenerator.begin();
-					auto end = knightGenerator.end();
-					if (it != end) {
-						return MovePositionAndPieceState{
-							.position = position,
-							.pieceState = KnightState{.it = std::move(it), .end = std::move(end)}};
-					}
-					break;
-				}
-				case chss::PieceType::Bishop: {
-					const auto bishopGenerator = chss::move_generation::BishopPseudoLegalMoves(state, position);
-					auto it = bishopGenerator.begin();
-					auto end = bishopGenerator.end();
-					if (it != end) {
-						return MovePositionAndPieceState{
-							.position = position,
-							.pieceState = BishopState{.it = std::move(it), .end = std::move(end)}};
-					}
-					break;
-				}
-				case chss::PieceType::Rook: {
-					const auto rookGenerator = chss::move_generation::RookPseudoLegalMoves(state, position);
-					auto it = rookGenerator.begin();
-					auto end = rookGenerator.end();
-					if (it != end) {
-						return MovePositionAndPieceState{
-							.position = position,
-							.pieceState = RookState{.it = std::move(it), .end = std::move(end)}};
-					}
-					break;
-				}
-				case chss::PieceType::Queen: {
-					const auto queenGenerator = chss::move_generation::QueenPseudoLegalMoves(state, position);
-					auto it = queenGenerator.begin();
-					auto end = queenGenerator.end();
-					if (it != end) {
-						return MovePositionAndPieceState{
-							.position = position,
-							.pieceState = QueenState{.it = std::move(it), .end = std::move(end)}};
-					}
-					break;
-				}
-				case chss::PieceType::King: {
-					const auto kingGenerator = chss::move_generation::KingPseudoLegalMoves(state, position);
-					auto it = kingGenerator.begin();
-					auto end = kingGenerator.end();
-					if (it != end) {
-						return MovePositionAndPieceState{
-							.position = position,
-							.pieceState = KingState{.it = std::move(it), .end = std::move(end)}};
-					}
-					break;
-				}
-				}
-			}
-			++x;
+// The first move of the generator of the piece at the given position, if it has any.
+template<chss::Color kColor, typename Generator>
+[[nodiscard]] constexpr std::optional<MovePositionAndPieceState<kColor>> FindFirstPieceMove(
+	const Generator& generator,
+	const chss::Position& position) {
+	auto it = generator.begin();
+	auto end = generator.end();
+	if (it == end) {
+		return std::nullopt;
+	}
+	return MovePositionAndPieceState<kColor>{
+		.position = position,
+		.pieceState = PieceMovesState<Generator>{.it = std::move(it), .end = std::move(end)}};
+}
+
+// The first move of the pieces of the active color, from the square with the given index (row by row) on. Past the last
+// move, the position is one past the board.
+template<chss::Color kColor>
+[[nodiscard]] constexpr MovePositionAndPieceState<kColor> FindMoveFrom(const chss::State& state, int squareIndex) {
+	const auto [sizeY, sizeX] = state.board.GetSize();
+	for (; squareIndex < sizeY * sizeX; ++squareIndex) {
+		const auto position = chss::Position{.y = squareIndex / sizeX, .x = squareIndex % sizeX};
+		const auto& pieceOpt = state.board.At(position);
+		if (!pieceOpt.has_value() || pieceOpt.value().color != kColor) {
+			continue;
+		}
+		auto moveOpt = std::optional<MovePositionAndPieceState<kColor>>();
+		switch (pieceOpt.value().type) {
+		case chss::PieceType::Pawn:
+			moveOpt = FindFirstPieceMove<kColor>(PawnMovesGenerator<kColor>(state, position), position);
+			break;
+		case chss::PieceType::Knight:
+			moveOpt = FindFirstPieceMove<kColor>(KnightMovesGenerator<kColor>(state, position), position);
+			break;
+		case chss::PieceType::Bishop:
+			moveOpt = FindFirstPieceMove<kColor>(BishopMovesGenerator<kColor>(state, position), position);
+			break;
+		case chss::PieceType::Rook:
+			moveOpt = FindFirstPieceMove<kColor>(RookMovesGenerator<kColor>(state, position), position);
+			break;
+		case chss::PieceType::Queen:
+			moveOpt = FindFirstPieceMove<kColor>(QueenMovesGenerator<kColor>(state, position), position);
+			break;
+		case chss::PieceType::King:
+			moveOpt = FindFirstPieceMove<kColor>(KingMovesGenerator<kColor>(state, position), position);
+			break;
+		case chss::PieceType::OffBoard:
+			// Only around the mailbox board, never on one of the squares that the loop goes through.
+			break;
+		}
+		if (moveOpt.has_value()) {
+			return moveOpt.value();
 		}
-		x = 0;
-		++y;
 	}
-	assert(false);
-	return MovePositionAndPieceState{
-		.position = chss::Position{.y = state.board.GetSize().sizeY, .x = state.board.GetSize().sizeX},
-		.pieceState = PawnState{
-			.it = chss::move_generation::PawnPseudoLegalMoves(state, chss::Position{.y = 7, .x = 7}).begin(),
-			.end = PawnState::Sentinel{}}};
+	return MovePositionAndPieceState<kColor>{
+		.position = chss::Position{.y = sizeY, .x = sizeX},
+		.pieceState = PieceMovesState<PawnMovesGenerator<kColor>>{
+			.it = PawnMovesGenerator<kColor>(state, chss::Position{.y = 7, .x = 7}).begin(),
+			.end = typename PawnMovesGenerator<kColor>::Sentinel{}}};
 }
 
-[[nodiscard]] constexpr MovePositionAndPieceState FindNextMove(
+template<chss::Color kColor>
+[[nodiscard]] constexpr MovePositionAndPieceState<kColor> FindNextMove(
 	const chss::State& state,
-	const MovePositionAndPieceState& startMove) {
+	const MovePositionAndPieceState<kColor>& startMove) {
 	return std::visit(
-		[position = startMove.position, &state](auto pieceState) -> MovePositionAndPieceState {
+		[position = startMove.position, &state](auto pieceState) -> MovePositionAndPieceState<kColor> {
 			++pieceState.it;
 			if (pieceState.it != pieceState.end) {
-				return MovePositionAndPieceState{.position = position, .pieceState = pieceState};
+				return MovePositionAndPieceState<kColor>{.position = position, .pieceState = pieceState};
 			}
-			int y = position.y;
-			int x = position.x + 1;
-			while (y < state.board.GetSize().sizeY) {
-				while (x < state.board.GetSize().sizeX) {
-					const auto newPosition = chss::Position{.y = y, .x = x};
-					const auto& pieceOpt = state.board.At(newPosition);
-					if (pieceOpt.has_value() && pieceOpt.value().color == state.activeColor) {
-						switch (pieceOpt.value().type) {
-						case chss::PieceType::Pawn: {
-							const auto pawnGenerator = chss::move_generation::PawnPseudoLegalMoves(state, newPosition);
-							auto it = pawnGenerator.begin();
-							auto end = pawnGenerator.end();
-							if (it != end) {
-								return MovePositionAndPieceState{
-									.position = newPosition,
-									.pieceState = PawnState{.it = std::move(it), .end = std::move(end)}};
-							}
-							break;
-						}
-						case chss::PieceType::Knight: {
-							const auto knightGenerator = chss::move_generation::KnightPseudoLegalMoves(state, newPosition);
-							auto it = knightGenerator.begin();
-							auto end = knightGenerator.end();
-							if (it != end) {
-								return MovePositionAndPieceState{
-									.position = newPosition,
-									.pieceState = KnightState{.it = std::move(it), .end = std::move(end)}};
-							}
-							break;
-						}
-						case chss::PieceType::Bishop: {
-							const auto bishopGenerator = chss::move_generation::BishopPseudoLegalMoves(state, newPosition);
-							auto it = bishopGenerator.begin();
-							auto end = bishopGenerator.end();
-							if (it != end) {
-								return MovePositionAndPieceState{
-									.position = newPosition,
-									.pieceState = BishopState{.it = std::move(it), .end = std::move(end)}};
-							}
-							break;
-						}
-						case chss::PieceType::Rook: {
-							const auto rookGenerator = chss::move_generation::RookPseudoLegalMoves(state, newPosition);
-							auto it = rookGenerator.begin();
-							auto end = rookGenerator.end();
-							if (it != end) {
-								return MovePositionAndPieceState{
-									.position = newPosition,
-									.pieceState = RookState{.it = std::move(it), .end = std::move(end)}};
-							}
-							break;
-						}
-						case chss::PieceType::Queen: {
-							const auto queenGenerator = chss::move_generation::QueenPseudoLegalMoves(state, newPosition);
-							auto it = queenGenerator.begin();
-							auto end = queenGenerator.end();
-							if (it != end) {
-								return MovePositionAndPieceState{
-									.position = newPosition,
-									.pieceState = QueenState{.it = std::move(it), .end = std::move(end)}};
-							}
-							break;
-						}
-						case chss::PieceType::King: {
-							const auto kingGenerator = chss::move_generation::KingPseudoLegalMoves(state, newPosition);
-							auto it = kingGenerator.begin();
-							auto end = kingGenerator.end();
-							if (it != end) {
-								return MovePositionAndPieceState{
-									.position = newPosition,
-									.pieceState = KingState{.it = std::move(it), .end = std::move(end)}};
-							}
-							break;
-						}
-						}
-					}
-					++x;
-				}
-				x = 0;
-				++y;
-			}
-			return MovePositionAndPieceState{
-				.position = chss::Position{.y = state.board.GetSize().sizeY, .x = state.board.GetSize().sizeX},
-				.pieceState = PawnState{
-					.it = chss::move_generation::PawnPseudoLegalMoves(state, chss::Position{.y = 7, .x = 7}).begin(),
-					.end = PawnState::Sentinel{}}};
+			return FindMoveFrom<kColor>(state, position.y * state.board.GetSize().sizeX + position.x + 1);
 		},
 		startMove.pieceState);
 }
 
+template<chss::Color kColor>
 class PseudoLegalMovesGenerator {
 public:
 	class Sentinel {};
@@ -291,7 +120,7 @@ public:
 	public:
 		constexpr explicit Iterator(const chss::State& state)
 			: mState(state)
-			, mPositionAndPieceState(FindFirstMove(state)) {}
+			, mPositionAndPieceState(FindMoveFrom<kColor>(state, 0)) {}
 
 		[[nodiscard]] constexpr chss::Move operator*() const {
 			assert(mPositionAndPieceState.position.y < mState.board.GetSize().sizeY);
@@ -310,7 +139,7 @@ public:
 				std::visit(
 					[](const auto& pieceState) { return pieceState.it != pieceState.end; },
 					mPositionAndPieceState.pieceState));
-			mPositionAndPieceState = FindNextMove(mState, mPositionAndPieceState);
+			mPositionAndPieceState = FindNextMove<kColor>(mState, mPositionAndPieceState);
 			return *this;
 		}
 
@@ -324,11 +153,13 @@ public:
 
 	private:
 		chss::State mState;
-		MovePositionAndPieceState mPositionAndPieceState;
+		MovePositionAndPieceState<kColor> mPositionAndPieceState;
 	};
 
 	constexpr explicit PseudoLegalMovesGenerator(const chss::State& state)
-		: mState(state) {}
+		: mState(state) {
+		assert(state.activeColor == kColor);
+	}
 
 	[[nodiscard]] constexpr Iterator begin() const {
 		return Iterator(mState);
@@ -347,7 +178,13 @@ private:
 namespace chss::move_generation {
 
 [[nodiscard]] constexpr auto PseudoLegalMoves(const State& state) {
-	return detail::PseudoLegalMovesGenerator(state);
+	return detail::ActiveColorGenerator<detail::PseudoLegalMovesGenerator>(state);
+}
+
+// For the active color kColor.
+template<Color kColor>
+[[nodiscard]] constexpr auto PseudoLegalMoves(const State& state) {
+	return detail::PseudoLegalMovesGenerator<kColor>(state);
 }
 
 } // namespace chss::move_generation
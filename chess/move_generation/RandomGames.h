@@ -0,0 +1,53 @@
+#pragma once
+
+#include "chess/fen/Fen.h"
+#include "chess/move_generation/LegalMoves.h"
+#include "chess/move_generation/MakeMove.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace chss::move_generation {
+
+/**
+ * Plays random games and calls visit(state, legalMoves) in each of their positions, numPositions times in total. The
+ * games start from a few test positions, in turn, and restart when they end or reach 200 plies. The seed is fixed, so
+ * every call walks the same positions. For the tests that compare two ways of answering the same question.
+ */
+template<typename Visit>
+void ForEachRandomGamePosition(const int numPositions, Visit visit) {
+	constexpr auto kFens = std::array<std::string_view, 4>{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"};
+	constexpr auto kMaxGamePlies = 200;
+	auto randomNumberEngine = std::minstd_rand(1070372);
+
+	auto state = fen::Parse(kFens[0]);
+	auto legalMoves = std::vector<Move>();
+	int gamePlies = 0;
+	for (int i = 0; i < numPositions; ++i) {
+		legalMoves.clear();
+		for (const auto move : LegalMoves(state)) {
+			legalMoves.push_back(move);
+		}
+		visit(state, legalMoves);
+
+		++gamePlies;
+		if (legalMoves.empty() || gamePlies == kMaxGamePlies) {
+			state = fen::Parse(kFens[static_cast<std::size_t>(i) % kFens.size()]);
+			gamePlies = 0;
+			continue;
+		}
+		const auto moveIndex = std::uniform_int_distribution<std::size_t>(0, legalMoves.size() - 1)(randomNumberEngine);
+		state = MakeMove(state, legalMoves[moveIndex]);
+	}
+}
+
+} // namespace chss::move_generation
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "chess/move_generation/ActiveColorGenerator.h"
 #include "chess/move_generation/IsInCheck.h"
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
@@ -19,10 +20,12 @@ constexpr auto kKingMoveOffsets = std::array<matrix::Direction2D, 10>{
 	matrix::Direction2D{.deltaY = +0, .deltaX = +2},
 };
 
+template<chss::Color kColor>
 constexpr std::size_t FindNextKingMoveOffsetIndex(
 	const chss::State& state,
 	const chss::Position& kingPosition,
 	const std::size_t startIndex) {
+	constexpr int y = kColor == chss::Color::White ? 0 : 7;
 	std::size_t i = startIndex;
 	while (i < kKingMoveOffsets.size()) {
 		const auto position = kingPosition + kKingMoveOffsets[i];
@@ -37,31 +40,28 @@ constexpr std::size_t FindNextKingMoveOffsetIndex(
 		case 7: {
 			if (state.board.IsInside(position)) {
 				const auto& pieceOpt = state.board.At(position);
-				if (!pieceOpt.has_value() || pieceOpt.value().color != state.activeColor) {
+				if (!pieceOpt.has_value() || pieceOpt.value().color != kColor) {
 					return i;
 				}
 			}
 			break;
 		}
 		case 8: { // Castling Queen side
-			const auto y = state.activeColor == chss::Color::White ? 0 : 7;
-			const bool isQueenSideAvailable = state.activeColor == chss::Color::White
-				? state.castlingAvailabilities.white.isQueenSideAvailable
-				: state.castlingAvailabilities.black.isQueenSideAvailable;
-			if (isQueenSideAvailable && kingPosition == chss::Position{.y = y, .x = 4}) {
+			if (chss::HasCastlingRights(state.castlingRights, chss::QueenSideCastlingRights(kColor)) &&
+				kingPosition == chss::Position{.y = y, .x = 4}) {
 				bool isInBetweenEmpty = true;
 				for (int x = 3; x >= 1; --x) {
 					const auto to = chss::Position{.y = y, .x = x};
 					isInBetweenEmpty = isInBetweenEmpty && !state.board.At(to).has_value();
 				}
-				bool isInBetweenSafe = !chss::move_generation::IsInCheck(state.board, state.activeColor, kingPosition);
+				bool isInBetweenSafe = !chss::move_generation::IsInCheck<kColor>(state.board, kingPosition);
 				for (int x = 3; x >= 2; --x) {
 					const auto inBetweenPosition = chss::Position{.y = y, .x = x};
 					auto newBoard = state.board;
 					newBoard.At(inBetweenPosition) = newBoard.At(kingPosition);
 					newBoard.At(kingPosition) = std::nullopt;
 					isInBetweenSafe = isInBetweenSafe &&
-						!chss::move_generation::IsInCheck(newBoard, state.activeColor, inBetweenPosition);
+						!chss::move_generation::IsInCheck<kColor>(newBoard, inBetweenPosition);
 				}
 				if (isInBetweenEmpty && isInBetweenSafe) {
 					return i;
@@ -70,24 +70,21 @@ constexpr std::size_t FindNextKingMoveOffsetIndex(
 			break;
 		}
 		case 9: { // Castling King side
-			const auto y = state.activeColor == chss::Color::White ? 0 : 7;
-			const bool isKingSideAvailable = state.activeColor == chss::Color::White
-				? state.castlingAvailabilities.white.isKingSideAvailable
-				: state.castlingAvailabilities.black.isKingSideAvailable;
-			if (isKingSideAvailable && kingPosition == chss::Position{.y = y, .x = 4}) {
+			if (chss::HasCastlingRights(state.castlingRights, chss::KingSideCastlingRights(kColor)) &&
+				kingPosition == chss::Position{.y = y, .x = 4}) {
 				bool isInBetweenEmpty = true;
 				for (int x = 5; x <= 6; ++x) {
 					const auto to = chss::Position{.y = y, .x = x};
 					isInBetweenEmpty = isInBetweenEmpty && !state.board.At(to).has_value();
 				}
-				bool isInBetweenSafe = !chss::move_generation::IsInCheck(state.board, state.activeColor, kingPosition);
+				bool isInBetweenSafe = !chss::move_generation::IsInCheck<kColor>(state.board, kingPosition);
 				for (int x = 5; x <= 6; ++x) {
 					const auto inBetweenPosition = chss::Position{.y = y, .x = x};
 					auto newBoard = state.board;
 					newBoard.At(inBetweenPosition) = newBoard.At(kingPosition);
 					newBoard.At(kingPosition) = std::nullopt;
 					isInBetweenSafe = isInBetweenSafe &&
-						!chss::move_generation::IsInCheck(newBoard, state.activeColor, inBetweenPosition);
+						!chss::move_generation::IsInCheck<kColor>(newBoard, inBetweenPosition);
 				}
 				if (isInBetweenEmpty && isInBetweenSafe) {
 					return i;
@@ -101,6 +98,7 @@ constexpr std::size_t FindNextKingMoveOffsetIndex(
 	return i;
 }
 
+template<chss::Color kColor>
 class KingMovesGenerator {
 public:
 	class Sentinel {};
@@ -110,7 +108,7 @@ public:
 		constexpr explicit Iterator(const chss::State& state, const chss::Position& kingPosition)
 			: mState(state)
 			, mKingPosition(kingPosition)
-			, mMoveOffsetIndex(FindNextKingMoveOffsetIndex(state, kingPosition, 0)) {}
+			, mMoveOffsetIndex(FindNextKingMoveOffsetIndex<kColor>(state, kingPosition, 0)) {}
 
 		[[nodiscard]] constexpr chss::Move operator*() const {
 			assert(mMoveOffsetIndex < kKingMoveOffsets.size());
@@ -122,7 +120,7 @@ public:
 
 		constexpr Iterator& operator++() {
 			assert(mMoveOffsetIndex < kKingMoveOffsets.size());
-			mMoveOffsetIndex = FindNextKingMoveOffsetIndex(mState, mKingPosition, mMoveOffsetIndex + 1);
+			mMoveOffsetIndex = FindNextKingMoveOffsetIndex<kColor>(mState, mKingPosition, mMoveOffsetIndex + 1);
 			return *this;
 		}
 
@@ -142,7 +140,9 @@ public:
 
 	constexpr explicit KingMovesGenerator(const chss::State& state, const chss::Position& kingPosition)
 		: mState(state)
-		, mKingPosition(kingPosition) {}
+		, mKingPosition(kingPosition) {
+		assert(state.activeColor == kColor);
+	}
 
 	[[nodiscard]] constexpr Iterator begin() const {
 		return Iterator(mState, mKingPosition);
@@ -162,7 +162,13 @@ private:
 namespace chss::move_generation {
 
 [[nodiscard]] constexpr auto KingPseudoLegalMoves(const State& state, const Position& kingPosition) {
-	return detail::KingMovesGenerator(state, kingPosition);
+	return detail::ActiveColorGenerator<detail::KingMovesGenerator>(state, kingPosition);
+}
+
+// For the king of the active color kColor.
+template<Color kColor>
+[[nodiscard]] constexpr auto KingPseudoLegalMoves(const State& state, const Position& kingPosition) {
+	return detail::KingMovesGenerator<kColor>(state, kingPosition);
 }
 
 } // namespace chss::move_generation
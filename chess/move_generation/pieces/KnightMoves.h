@@ -1,5 +1,6 @@
 #pragma once
 
+#include "chess/move_generation/ActiveColorGenerator.h"
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
 
@@ -16,6 +17,7 @@ constexpr auto kKnightMoveOffsets = std::array<matrix::Direction2D, 8>{
 	matrix::Direction2D{.deltaY = +2, .deltaX = +1},
 };
 
+template<chss::Color kColor>
 constexpr std::size_t FindNextKnightMoveOffsetIndex(
 	const chss::State& state,
 	const chss::Position& knightPosition,
@@ -24,7 +26,7 @@ constexpr std::size_t FindNextKnightMoveOffsetIndex(
 	while (i < kKnightMoveOffsets.size()) {
 		const auto position = knightPosition + kKnightMoveOffsets[i];
 		if (state.board.IsInside(position) &&
-			(!state.board.At(position).has_value() || state.board.At(position).value().color != state.activeColor)) {
+			(!state.board.At(position).has_value() || state.board.At(position).value().color != kColor)) {
 			return i;
 		}
 		++i;
@@ -32,6 +34,7 @@ constexpr std::size_t FindNextKnightMoveOffsetIndex(
 	return i;
 }
 
+template<chss::Color kColor>
 class KnightMovesGenerator {
 public:
 	class Sentinel {};
@@ -41,7 +44,7 @@ public:
 		constexpr explicit Iterator(const chss::State& state, const chss::Position& knightPosition)
 			: mState(state)
 			, mKnightPosition(knightPosition)
-			, mMoveOffsetIndex(FindNextKnightMoveOffsetIndex(state, knightPosition, 0)) {}
+			, mMoveOffsetIndex(FindNextKnightMoveOffsetIndex<kColor>(state, knightPosition, 0)) {}
 
 		[[nodiscard]] constexpr chss::Move operator*() const {
 			assert(mMoveOffsetIndex < kKnightMoveOffsets.size());
@@ -53,7 +56,7 @@ public:
 
 		constexpr Iterator& operator++() {
 			assert(mMoveOffsetIndex < kKnightMoveOffsets.size());
-			mMoveOffsetIndex = FindNextKnightMoveOffsetIndex(mState, mKnightPosition, mMoveOffsetIndex + 1);
+			mMoveOffsetIndex = FindNextKnightMoveOffsetIndex<kColor>(mState, mKnightPosition, mMoveOffsetIndex + 1);
 			return *this;
 		}
 
@@ -73,7 +76,9 @@ public:
 
 	constexpr explicit KnightMovesGenerator(const chss::State& state, const chss::Position& knightPosition)
 		: mState(state)
-		, mKnightPosition(knightPosition) {}
+		, mKnightPosition(knightPosition) {
+		assert(state.activeColor == kColor);
+	}
 
 	[[nodiscard]] constexpr Iterator begin() const {
 		return Iterator(mState, mKnightPosition);
@@ -93,7 +98,13 @@ private:
 namespace chss::move_generation {
 
 [[nodiscard]] constexpr auto KnightPseudoLegalMoves(const State& state, const Position& knightPosition) {
-	return detail::KnightMovesGenerator(state, knightPosition);
+	return detail::ActiveColorGenerator<detail::KnightMovesGenerator>(state, knightPosition);
+}
+
+// For knights of the active color kColor.
+template<Color kColor>
+[[nodiscard]] constexpr auto KnightPseudoLegalMoves(const State& state, const Position& knightPosition) {
+	return detail::KnightMovesGenerator<kColor>(state, knightPosition);
 }
 
 } // namespace chss::move_generation
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "chess/move_generation/ActiveColorGenerator.h"
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
 
@@ -56,14 +57,23 @@ constexpr auto kPawnMoveOffsets = std::array<std::pair<matrix::Direction2D, std:
 		std::nullopt),
 };
 
+// The offsets are the ones of white pawns, black pawns move the other way.
+template<chss::Color kColor>
+[[nodiscard]] constexpr chss::Position PawnMoveDestination(const chss::Position& pawnPosition, const std::size_t index) {
+	return kColor == chss::Color::White ? pawnPosition + kPawnMoveOffsets[index].first
+										: pawnPosition - kPawnMoveOffsets[index].first;
+}
+
+template<chss::Color kColor>
 constexpr std::size_t FindNextPawnMoveOffsetIndex(
 	const chss::State& state,
 	const chss::Position& pawnPosition,
 	const std::size_t startIndex) {
+	constexpr int kStartRank = kColor == chss::Color::White ? 1 : 6;
+	constexpr int kForward = kColor == chss::Color::White ? 1 : -1;
 	std::size_t i = startIndex;
 	while (i < kPawnMoveOffsets.size()) {
-		const auto position = state.activeColor == chss::Color::White ? pawnPosition + kPawnMoveOffsets[i].first
-																	  : pawnPosition - kPawnMoveOffsets[i].first;
+		const auto position = PawnMoveDestination<kColor>(pawnPosition, i);
 		switch (i) {
 		case 0: { // Advance
 			if (0 < position.y && position.y < 7 && !state.board.At(position).has_value()) {
@@ -85,8 +95,7 @@ constexpr std::size_t FindNextPawnMoveOffsetIndex(
 		case 5:
 		case 6: { // Capture left and right
 			if (state.board.IsInside(position) && (position.y > 0 && position.y < 7) &&
-				((state.board.At(position).has_value() &&
-				  state.board.At(position).value().color != state.activeColor) ||
+				((state.board.At(position).has_value() && state.board.At(position).value().color != kColor) ||
 				 state.enPassantTargetSquare == position)) {
 				return i;
 			}
@@ -101,20 +110,16 @@ constexpr std::size_t FindNextPawnMoveOffsetIndex(
 		case 13:
 		case 14: { // Capture + Promotion
 			if (state.board.IsInside(position) && (position.y == 0 || position.y == 7) &&
-				((state.board.At(position).has_value() &&
-				  state.board.At(position).value().color != state.activeColor) ||
+				((state.board.At(position).has_value() && state.board.At(position).value().color != kColor) ||
 				 state.enPassantTargetSquare == position)) {
 				return i;
 			}
 			break;
 		}
 		case 15: { // Double Advance
-			if ((pawnPosition.y == 1 && state.activeColor == chss::Color::White &&
-				 !state.board.At(chss::Position{.y = 2, .x = pawnPosition.x}).has_value() &&
-				 !state.board.At(chss::Position{.y = 3, .x = pawnPosition.x}).has_value()) ||
-				(pawnPosition.y == 6 && state.activeColor == chss::Color::Black &&
-				 !state.board.At(chss::Position{.y = 5, .x = pawnPosition.x}).has_value() &&
-				 !state.board.At(chss::Position{.y = 4, .x = pawnPosition.x}).has_value())) {
+			if (pawnPosition.y == kStartRank &&
+				!state.board.At(chss::Position{.y = kStartRank + kForward, .x = pawnPosition.x}).has_value() &&
+				!state.board.At(chss::Position{.y = kStartRank + 2 * kForward, .x = pawnPosition.x}).has_value()) {
 				return i;
 			}
 			break;
@@ -125,6 +130,7 @@ constexpr std::size_t FindNextPawnMoveOffsetIndex(
 	return i;
 }
 
+template<chss::Color kColor>
 class PawnMovesGenerator {
 public:
 	class Sentinel {};
@@ -134,21 +140,19 @@ public:
 		constexpr explicit Iterator(const chss::State& state, const chss::Position& pawnPosition)
 			: mState(state)
 			, mPawnPosition(pawnPosition)
-			, mMoveOffsetIndex(FindNextPawnMoveOffsetIndex(state, pawnPosition, 0)) {}
+			, mMoveOffsetIndex(FindNextPawnMoveOffsetIndex<kColor>(state, pawnPosition, 0)) {}
 
 		[[nodiscard]] constexpr chss::Move operator*() const {
 			assert(mMoveOffsetIndex < kPawnMoveOffsets.size());
 			return chss::Move{
 				.from = mPawnPosition,
-				.to = mState.activeColor == chss::Color::White
-					? mPawnPosition + kPawnMoveOffsets[mMoveOffsetIndex].first
-					: mPawnPosition - kPawnMoveOffsets[mMoveOffsetIndex].first,
+				.to = PawnMoveDestination<kColor>(mPawnPosition, mMoveOffsetIndex),
 				.promotionType = kPawnMoveOffsets[mMoveOffsetIndex].second};
 		}
 
 		constexpr Iterator& operator++() {
 			assert(mMoveOffsetIndex < kPawnMoveOffsets.size());
-			mMoveOffsetIndex = FindNextPawnMoveOffsetIndex(mState, mPawnPosition, mMoveOffsetIndex + 1);
+			mMoveOffsetIndex = FindNextPawnMoveOffsetIndex<kColor>(mState, mPawnPosition, mMoveOffsetIndex + 1);
 			return *this;
 		}
 
@@ -168,7 +172,9 @@ public:
 
 	constexpr explicit PawnMovesGenerator(const chss::State& state, const chss::Position& pawnPosition)
 		: mState(state)
-		, mPawnPosition(pawnPosition) {}
+		, mPawnPosition(pawnPosition) {
+		assert(state.activeColor == kColor);
+	}
 
 	[[nodiscard]] constexpr Iterator begin() const {
 		return Iterator(mState, mPawnPosition);
@@ -188,7 +194,13 @@ private:
 namespace chss::move_generation {
 
 [[nodiscard]] constexpr auto PawnPseudoLegalMoves(const State& state, const Position& pawnPosition) {
-	return detail::PawnMovesGenerator(state, pawnPosition);
+	return detail::ActiveColorGenerator<detail::PawnMovesGenerator>(state, pawnPosition);
+}
+
+// For pawns of the active color kColor.
+template<Color kColor>
+[[nodiscard]] constexpr auto PawnPseudoLegalMoves(const State& state, const Position& pawnPosition) {
+	return detail::PawnMovesGenerator<kColor>(state, pawnPosition);
 }
 
 } // namespace chss::move_generation
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "chess/move_generation/ActiveColorGenerator.h"
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
 
@@ -35,7 +36,7 @@ struct MoveOffsetIndexAndFactor {
 	int factor;
 };
 
-template<std::size_t S, std::array<matrix::Direction2D, S> kMoveOffsets>
+template<chss::Color kColor, std::size_t S, std::array<matrix::Direction2D, S> kMoveOffsets>
 constexpr MoveOffsetIndexAndFactor FindNextMoveOffsetIndexAndFactor(
 	const chss::State& state,
 	const chss::Position& piecePosition,
@@ -48,8 +49,8 @@ constexpr MoveOffsetIndexAndFactor FindNextMoveOffsetIndexAndFactor(
 	}
 	while (i < kMoveOffsets.size()) {
 		const auto position = piecePosition + kMoveOffsets[i] * f;
-		if (state.board.IsInside(position) &&
-			(!state.board.At(position) || state.board.At(position).value().color != state.activeColor)) {
+		if (chss::IsOnBoard(state.board, position) &&
+			(!state.board.At(position) || state.board.At(position).value().color != kColor)) {
 			return MoveOffsetIndexAndFactor{.index = i, .factor = f};
 		}
 		f = 1;
@@ -58,7 +59,7 @@ constexpr MoveOffsetIndexAndFactor FindNextMoveOffsetIndexAndFactor(
 	return MoveOffsetIndexAndFactor{.index = i, .factor = f};
 }
 
-template<std::size_t S, std::array<matrix::Direction2D, S> kMoveOffsets>
+template<chss::Color kColor, std::size_t S, std::array<matrix::Direction2D, S> kMoveOffsets>
 class SlidingPieceMovesGenerator {
 public:
 	class Sentinel {};
@@ -69,7 +70,7 @@ public:
 			: mState(state)
 			, mPiecePosition(piecePosition)
 			, mMoveOffsetIndexAndFactor(
-				  FindNextMoveOffsetIndexAndFactor<S, kMoveOffsets>(
+				  FindNextMoveOffsetIndexAndFactor<kColor, S, kMoveOffsets>(
 					  state,
 					  piecePosition,
 					  MoveOffsetIndexAndFactor{.index = 0, .factor = 1})) {}
@@ -89,13 +90,13 @@ public:
 			const auto position = mPiecePosition + kMoveOffsets[moveOffsetIndex] * moveOffsetFactor;
 			const auto& pieceOpt = mState.board.At(position);
 			if (pieceOpt.has_value()) {
-				assert(pieceOpt.value().color != mState.activeColor);
-				mMoveOffsetIndexAndFactor = FindNextMoveOffsetIndexAndFactor<S, kMoveOffsets>(
+				assert(pieceOpt.value().color != kColor);
+				mMoveOffsetIndexAndFactor = FindNextMoveOffsetIndexAndFactor<kColor, S, kMoveOffsets>(
 					mState,
 					mPiecePosition,
 					MoveOffsetIndexAndFactor{.index = moveOffsetIndex + 1, .factor = 1});
 			} else {
-				mMoveOffsetIndexAndFactor = FindNextMoveOffsetIndexAndFactor<S, kMoveOffsets>(
+				mMoveOffsetIndexAndFactor = FindNextMoveOffsetIndexAndFactor<kColor, S, kMoveOffsets>(
 					mState,
 					mPiecePosition,
 					MoveOffsetIndexAndFactor{.index = moveOffsetIndex, .factor = moveOffsetFactor + 1});
@@ -119,9 +120,11 @@ public:
 		MoveOffsetIndexAndFactor mMoveOffsetIndexAndFactor;
 	};
 
-	constexpr explicit SlidingPieceMovesGenerator(const chss::State& state, const chss::Position& knightPosition)
+	constexpr explicit SlidingPieceMovesGenerator(const chss::State& state, const chss::Position& piecePosition)
 		: mState(state)
-		, mPiecePosition(knightPosition) {}
+		, mPiecePosition(piecePosition) {
+		assert(state.activeColor == kColor);
+	}
 
 	[[nodiscard]] constexpr Iterator begin() const {
 		return Iterator(mState, mPiecePosition);
@@ -136,20 +139,45 @@ private:
 	chss::Position mPiecePosition;
 };
 
+template<chss::Color kColor>
+using BishopMovesGenerator = SlidingPieceMovesGenerator<kColor, 4, kBishopMoveOffsets>;
+
+template<chss::Color kColor>
+using RookMovesGenerator = SlidingPieceMovesGenerator<kColor, 4, kRookMoveOffsets>;
+
+template<chss::Color kColor>
+using QueenMovesGenerator = SlidingPieceMovesGenerator<kColor, 8, kQueenMoveOffsets>;
+
 } // namespace detail
 
 namespace chss::move_generation {
 
-[[nodiscard]] constexpr auto BishopPseudoLegalMoves(const State& state, const Position& knightPosition) {
-	return detail::SlidingPieceMovesGenerator<4, detail::kBishopMoveOffsets>(state, knightPosition);
+[[nodiscard]] constexpr auto BishopPseudoLegalMoves(const State& state, const Position& bishopPosition) {
+	return detail::ActiveColorGenerator<detail::BishopMovesGenerator>(state, bishopPosition);
+}
+
+[[nodiscard]] constexpr auto RookPseudoLegalMoves(const State& state, const Position& rookPosition) {
+	return detail::ActiveColorGenerator<detail::RookMovesGenerator>(state, rookPosition);
+}
+
+[[nodiscard]] constexpr auto QueenPseudoLegalMoves(const State& state, const Position& queenPosition) {
+	return detail::ActiveColorGenerator<detail::QueenMovesGenerator>(state, queenPosition);
+}
+
+// For pieces of the active color kColor.
+template<Color kColor>
+[[nodiscard]] constexpr auto BishopPseudoLegalMoves(const State& state, const Position& bishopPosition) {
+	return detail::BishopMovesGenerator<kColor>(state, bishopPosition);
 }
 
-[[nodiscard]] constexpr auto RookPseudoLegalMoves(const State& state, const Position& knightPosition) {
-	return detail::SlidingPieceMovesGenerator<4, detail::kRookMoveOffsets>(state, knightPosition);
+template<Color kColor>
+[[nodiscard]] constexpr auto RookPseudoLegalMoves(const State& state, const Position& rookPosition) {
+	return detail::RookMovesGenerator<kColor>(state, rookPosition);
 }
 
-[[nodiscard]] constexpr auto QueenPseudoLegalMoves(const State& state, const Position& knightPosition) {
-	return detail::SlidingPieceMovesGenerator<8, detail::kQueenMoveOffsets>(state, knightPosition);
+template<Color kColor>
+[[nodiscard]] constexpr auto QueenPseudoLegalMoves(const State& state, const Position& queenPosition) {
+	return detail::QueenMovesGenerator<kColor>(state, queenPosition);
 }
 
 } // namespace chss::move_generation
@@ -2,9 +2,13 @@
 
 #include "Piece.h"
 
+#include <matrix/BitMatrix2D.h>
 #include <matrix/Matrix2D.h>
+#include <matrix/PaddedMatrix2D.h>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 
 namespace chss {
@@ -77,8 +81,62 @@ constexpr auto G8 = Position{.y = 7, .x = 6};
 constexpr auto H8 = Position{.y = 7, .x = 7};
 } // namespace positions
 
+#ifdef CHSS_MAILBOX_BOARD
+// What the squares around the mailbox board hold. Its color means nothing: the code that reads around the board tests
+// IsOnBoard before it looks at the piece.
+inline constexpr auto kOffBoardSquare = std::optional<Piece>(Piece{.type = PieceType::OffBoard, .color = Color::White});
+
+// The 10x12 mailbox: 2 rows of off-board squares above and below the board, and 1 column on each side, which is enough
+// for the knight jumps. Selected with the CMake option CHSS_MAILBOX_BOARD.
+using Board = matrix::PaddedMatrix2D<
+	std::optional<Piece>,
+	matrix::Size2D{.sizeY = 8, .sizeX = 8},
+	matrix::Size2D{.sizeY = 2, .sizeX = 1},
+	kOffBoardSquare>;
+static_assert(sizeof(Board) == 120 * 3);
+#else
 using Board = matrix::Matrix2D<std::optional<Piece>, matrix::Size2D{.sizeY = 8, .sizeX = 8}>;
 static_assert(sizeof(Board) == 64 * 3);
+#endif
+
+// One bit per square: bit y * 8 + x for the square {y, x}, which is also its SquareIndex.
+using Bitboard = std::uint64_t;
+
+// The same bits as a Bitboard, with the shifts, counts and mirrors of the matrix library.
+using SquareSet = matrix::BitMatrix2D<matrix::Size2D{.sizeY = 8, .sizeX = 8}>;
+
+[[nodiscard]] constexpr std::size_t SquareIndex(const Position& position) {
+	return static_cast<std::size_t>(position.y * 8 + position.x);
+}
+
+[[nodiscard]] constexpr Position SquarePosition(const std::size_t squareIndex) {
+	return Position{.y = static_cast<int>(squareIndex / 8), .x = static_cast<int>(squareIndex % 8)};
+}
+
+[[nodiscard]] constexpr Bitboard SquareBitboard(const Position& position) {
+	return Bitboard{1} << SquareIndex(position);
+}
+
+// The square with the given SquareIndex.
+[[nodiscard]] constexpr const std::optional<Piece>& SquareAt(const Board& board, const std::size_t squareIndex) {
+#ifdef CHSS_MAILBOX_BOARD
+	return board.At(SquarePosition(squareIndex));
+#else
+	return board.GetData()[squareIndex];
+#endif
+}
+
+/**
+ * Whether the position, at most one step of a piece away from a square of the board, is on the board. The 8x8 board
+ * checks the bounds, the mailbox board reads the square and compares it with kOffBoardSquare.
+ */
+[[nodiscard]] constexpr bool IsOnBoard(const Board& board, const Position& position) {
+#ifdef CHSS_MAILBOX_BOARD
+	return board.At(position) != kOffBoardSquare;
+#else
+	return board.IsInside(position);
+#endif
+}
 
 constexpr auto kEmptyBoard = Board(std::optional<Piece>(std::nullopt));
 constexpr auto kInitialBoard = Board(
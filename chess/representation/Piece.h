@@ -4,7 +4,8 @@
 
 namespace chss {
 
-enum class PieceType : std::int8_t { Pawn, Knight, Bishop, Rook, Queen, King };
+// OffBoard is not a piece: it only fills the squares around the mailbox board (see kOffBoardSquare in Board.h).
+enum class PieceType : std::int8_t { Pawn, Knight, Bishop, Rook, Queen, King, OffBoard };
 
 enum class Color : std::int8_t { White, Black };
 
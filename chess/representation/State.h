@@ -2,31 +2,68 @@
 
 #include "Board.h"
 
+#include <cstdint>
 #include <optional>
 
 namespace chss {
 
-struct CastlingAvailability {
-	bool isKingSideAvailable;
-	bool isQueenSideAvailable;
-	[[nodiscard]] constexpr bool operator==(const CastlingAvailability& other) const = default;
+/**
+ * Castling rights of both colors, one bit per color and side of the board. A right only says that the king and the rook
+ * of that side have not moved (or the rook been captured) yet: castling can still be impossible in the position.
+ */
+enum class CastlingRights : std::uint8_t {
+	None = 0,
+	WhiteKingSide = 1 << 0,
+	WhiteQueenSide = 1 << 1,
+	BlackKingSide = 1 << 2,
+	BlackQueenSide = 1 << 3,
+	All = 0b1111,
 };
 
-struct CastlingAvailabilities {
-	CastlingAvailability white;
-	CastlingAvailability black;
-	[[nodiscard]] constexpr bool operator==(const CastlingAvailabilities& other) const = default;
-};
+[[nodiscard]] constexpr CastlingRights operator|(CastlingRights lhs, CastlingRights rhs) {
+	return static_cast<CastlingRights>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+}
+
+[[nodiscard]] constexpr CastlingRights operator&(CastlingRights lhs, CastlingRights rhs) {
+	return static_cast<CastlingRights>(static_cast<std::uint8_t>(lhs) & static_cast<std::uint8_t>(rhs));
+}
+
+// Only the 4 bits of the rights, so ~All == None.
+[[nodiscard]] constexpr CastlingRights operator~(CastlingRights rights) {
+	return static_cast<CastlingRights>(
+		~static_cast<std::uint8_t>(rights) & static_cast<std::uint8_t>(CastlingRights::All));
+}
+
+constexpr CastlingRights& operator|=(CastlingRights& lhs, CastlingRights rhs) {
+	return lhs = lhs | rhs;
+}
+
+constexpr CastlingRights& operator&=(CastlingRights& lhs, CastlingRights rhs) {
+	return lhs = lhs & rhs;
+}
+
+// Whether any of the rights of mask is in rights.
+[[nodiscard]] constexpr bool HasCastlingRights(CastlingRights rights, CastlingRights mask) {
+	return (rights & mask) != CastlingRights::None;
+}
+
+[[nodiscard]] constexpr CastlingRights KingSideCastlingRights(Color color) {
+	return color == Color::White ? CastlingRights::WhiteKingSide : CastlingRights::BlackKingSide;
+}
+
+[[nodiscard]] constexpr CastlingRights QueenSideCastlingRights(Color color) {
+	return color == Color::White ? CastlingRights::WhiteQueenSide : CastlingRights::BlackQueenSide;
+}
 
 struct State {
 	Board board;
 	Color activeColor;
-	CastlingAvailabilities castlingAvailabilities;
+	CastlingRights castlingRights;
 	std::optional<Position> enPassantTargetSquare;
 	int halfmoveClock;
 	int fullmoveNumber;
 	[[nodiscard]] constexpr bool operator==(const State& other) const = default;
 };
-static_assert(sizeof(State) == 220);
+static_assert(sizeof(State) == sizeof(Board) + 24);
 
 }
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "chess/representation/Move.h"
+#include "chess/representation/Piece.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+
+namespace chss::search {
+
+// Absolute value that history scores never exceed.
+constexpr int kMaxHistory = 16384;
+
+/**
+ * Piece and destination square of a move: what the continuation history and the counter-move table remember about the
+ * previous moves.
+ */
+struct PieceToSquare {
+	Piece piece;
+	Position to;
+	[[nodiscard]] constexpr bool operator==(const PieceToSquare& other) const = default;
+};
+
+} // namespace chss::search
+
+namespace detail {
+
+[[nodiscard]] constexpr std::size_t HistoryPieceIndex(const chss::Piece& piece) {
+	return static_cast<std::size_t>(piece.color) * 6 + static_cast<std::size_t>(piece.type);
+}
+
+[[nodiscard]] constexpr std::size_t HistorySquareIndex(const chss::Position& position) {
+	return static_cast<std::size_t>(position.y * 8 + position.x);
+}
+
+// History gravity: the closer a score is to kMaxHistory, the less a bonus of the same sign changes it, so old results
+// fade away as new ones arrive and the score stays within [-kMaxHistory, kMaxHistory].
+template<typename T>
+constexpr void ApplyHistoryBonus(T& score, const int bonus) {
+	const auto value = static_cast<int>(score);
+	score = static_cast<T>(value + bonus - value * std::abs(bonus) / chss::search::kMaxHistory);
+}
+
+} // namespace detail
+
+namespace chss::search {
+
+/**
+ * How often quiet moves caused beta cutoffs, by side, origin square and destination square ("butterfly" history).
+ */
+class ButterflyHistory {
+public:
+	[[nodiscard]] int Get(const Color color, const Move& move) const {
+		return mScores[Index(color, move)];
+	}
+
+	// bonus is positive for moves that caused a cutoff and negative for the quiet moves searched before them.
+	void Update(const Color color, const Move& move, const int bonus) {
+		detail::ApplyHistoryBonus(mScores[Index(color, move)], bonus);
+	}
+
+	void Clear() {
+		mScores.fill(0);
+	}
+
+private:
+	[[nodiscard]] static std::size_t Index(const Color color, const Move& move) {
+		return (static_cast<std::size_t>(color) * 64 + detail::HistorySquareIndex(move.from)) * 64 +
+			detail::HistorySquareIndex(move.to);
+	}
+
+	std::array<int, 2 * 64 * 64> mScores = {};
+};
+
+/**
+ * How often a quiet move (piece and destination) caused a beta cutoff after a given previous move (piece and
+ * destination), one or two plies before.
+ */
+class ContinuationHistory {
+public:
+	[[nodiscard]] int Get(const PieceToSquare& previous, const PieceToSquare& current) const {
+		return mScores[Index(previous, current)];
+	}
+
+	void Update(const PieceToSquare& previous, const PieceToSquare& current, const int bonus) {
+		detail::ApplyHistoryBonus(mScores[Index(previous, current)], bonus);
+	}
+
+	void Clear() {
+		mScores.fill(0);
+	}
+
+private:
+	[[nodiscard]] static std::size_t Index(const PieceToSquare& previous, const PieceToSquare& current) {
+		const auto previousIndex =
+			detail::HistoryPieceIndex(previous.piece) * 64 + detail::HistorySquareIndex(previous.to);
+		const auto currentIndex =
+			detail::HistoryPieceIndex(current.piece) * 64 + detail::HistorySquareIndex(current.to);
+		return previousIndex * 12 * 64 + currentIndex;
+	}
+
+	// kMaxHistory fits in 16 bits, which keeps the table at 1.1 MB.
+	std::array<std::int16_t, 12 * 64 * 12 * 64> mScores = {};
+};
+
+/**
+ * How often a capture (piece, destination and captured type) caused a beta cutoff.
+ */
+class CaptureHistory {
+public:
+	[[nodiscard]] int Get(const PieceToSquare& capture, const PieceType capturedType) const {
+		return mScores[Index(capture, capturedType)];
+	}
+
+	void Update(const PieceToSquare& capture, const PieceType capturedType, const int bonus) {
+		detail::ApplyHistoryBonus(mScores[Index(capture, capturedType)], bonus);
+	}
+
+	void Clear() {
+		mScores.fill(0);
+	}
+
+private:
+	[[nodiscard]] static std::size_t Index(const PieceToSquare& capture, const PieceType capturedType) {
+		return (detail::HistoryPieceIndex(capture.piece) * 64 + detail::HistorySquareIndex(capture.to)) * 6 +
+			static_cast<std::size_t>(capturedType);
+	}
+
+	std::array<int, 12 * 64 * 6> mScores = {};
+};
+
+/**
+ * The last quiet move that refuted a given previous move (piece and destination) with a beta cutoff.
+ */
+class CounterMoves {
+public:
+	[[nodiscard]] const std::optional<Move>& Get(const PieceToSquare& previous) const {
+		return mMoves[Index(previous)];
+	}
+
+	void Set(const PieceToSquare& previous, const Move& move) {
+		mMoves[Index(previous)] = move;
+	}
+
+	void Clear() {
+		mMoves.fill(std::nullopt);
+	}
+
+private:
+	[[nodiscard]] static std::size_t Index(const PieceToSquare& previous) {
+		return detail::HistoryPieceIndex(previous.piece) * 64 + detail::HistorySquareIndex(previous.to);
+	}
+
+	std::array<std::optional<Move>, 12 * 64> mMoves = {};
+};
+
+/**
+ * All the move ordering tables of a search thread. They are too big for the stack, so each thread allocates them once
+ * and keeps them from one search to the next.
+ */
+struct HistoryTables {
+	ButterflyHistory butterfly;
+	ContinuationHistory continuation;
+	CaptureHistory capture;
+	CounterMoves counterMoves;
+
+	void Clear() {
+		butterfly.Clear();
+		continuation.Clear();
+		capture.Clear();
+		counterMoves.Clear();
+	}
+};
+
+// History bonus of a move that caused a cutoff at the given depth.
+[[nodiscard]] constexpr int HistoryBonus(const int depth) {
+	return std::min(depth * depth * 16, kMaxHistory / 8);
+}
+
+} // namespace chss::search
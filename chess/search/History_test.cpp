@@ -0,0 +1,54 @@
+#include "History.h"
+
+#include "chess/representation/Board.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/Piece.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+namespace {
+
+constexpr auto kWhiteKnightToF3 = chss::search::PieceToSquare{
+	.piece = chss::Piece{.type = chss::PieceType::Knight, .color = chss::Color::White},
+	.to = chss::positions::F3};
+constexpr auto kBlackPawnToE5 = chss::search::PieceToSquare{
+	.piece = chss::Piece{.type = chss::PieceType::Pawn, .color = chss::Color::Black},
+	.to = chss::positions::E5};
+
+} // namespace
+
+TEST(History, ScoresStayWithinTheMaximum) {
+	auto histories = std::make_unique<chss::search::HistoryTables>();
+	const auto move = chss::Move{.from = chss::positions::G1, .to = chss::positions::F3, .promotionType = std::nullopt};
+	for (int i = 0; i < 1000; ++i) {
+		histories->butterfly.Update(chss::Color::White, move, chss::search::HistoryBonus(20));
+		histories->continuation.Update(kBlackPawnToE5, kWhiteKnightToF3, -chss::search::HistoryBonus(20));
+	}
+	EXPECT_GT(histories->butterfly.Get(chss::Color::White, move), 0);
+	EXPECT_LE(histories->butterfly.Get(chss::Color::White, move), chss::search::kMaxHistory);
+	EXPECT_EQ(histories->butterfly.Get(chss::Color::Black, move), 0);
+	EXPECT_LT(histories->continuation.Get(kBlackPawnToE5, kWhiteKnightToF3), 0);
+	EXPECT_GE(histories->continuation.Get(kBlackPawnToE5, kWhiteKnightToF3), -chss::search::kMaxHistory);
+	EXPECT_EQ(histories->continuation.Get(kWhiteKnightToF3, kBlackPawnToE5), 0);
+}
+
+TEST(History, ClearForgetsEverything) {
+	auto histories = std::make_unique<chss::search::HistoryTables>();
+	const auto move = chss::Move{.from = chss::positions::D7, .to = chss::positions::D6, .promotionType = std::nullopt};
+	histories->butterfly.Update(chss::Color::Black, move, 100);
+	histories->continuation.Update(kWhiteKnightToF3, kBlackPawnToE5, 100);
+	histories->capture.Update(kWhiteKnightToF3, chss::PieceType::Pawn, 100);
+	histories->counterMoves.Set(kWhiteKnightToF3, move);
+	EXPECT_EQ(histories->counterMoves.Get(kWhiteKnightToF3), move);
+	EXPECT_EQ(histories->counterMoves.Get(kBlackPawnToE5), std::nullopt);
+	EXPECT_EQ(histories->capture.Get(kWhiteKnightToF3, chss::PieceType::Pawn), 100);
+	EXPECT_EQ(histories->capture.Get(kWhiteKnightToF3, chss::PieceType::Knight), 0);
+
+	histories->Clear();
+	EXPECT_EQ(histories->butterfly.Get(chss::Color::Black, move), 0);
+	EXPECT_EQ(histories->continuation.Get(kWhiteKnightToF3, kBlackPawnToE5), 0);
+	EXPECT_EQ(histories->capture.Get(kWhiteKnightToF3, chss::PieceType::Pawn), 0);
+	EXPECT_EQ(histories->counterMoves.Get(kWhiteKnightToF3), std::nullopt);
+}
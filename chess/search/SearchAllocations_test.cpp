@@ -0,0 +1,165 @@
+#include "chess/MinMax.h"
+#include "chess/fen/Fen.h"
+#include "chess/search/Searcher.h"
+#include "chess/search/ThreadData.h"
+#include "chess/search/TranspositionTable.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <tuple>
+
+namespace {
+
+constexpr auto kKiwipete = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+// Heap allocations made by any thread while they are counted, so that the ones of the helper threads count too.
+std::atomic<bool> gIsCountingAllocations = false;
+std::atomic<int> gAllocations = 0;
+
+class AllocationCounter {
+public:
+	AllocationCounter() {
+		gAllocations.store(0);
+		gIsCountingAllocations.store(true);
+	}
+
+	~AllocationCounter() {
+		gIsCountingAllocations.store(false);
+	}
+
+	AllocationCounter(const AllocationCounter&) = delete;
+	AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+	[[nodiscard]] int GetAllocations() const {
+		return gAllocations.load();
+	}
+};
+
+} // namespace
+
+namespace {
+
+void* Allocate(const std::size_t size, const std::size_t alignment) {
+	if (gIsCountingAllocations.load(std::memory_order_relaxed)) {
+		gAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	// std::aligned_alloc needs a size that is a multiple of the alignment.
+	const auto alignedSize = (std::max(size, std::size_t{1}) + alignment - 1) / alignment * alignment;
+	if (void* pointer = std::aligned_alloc(alignment, alignedSize)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+} // namespace
+
+// All the replaceable forms that allocate, so that no allocation escapes the count. The nothrow forms call these.
+void* operator new(const std::size_t size) {
+	return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](const std::size_t size) {
+	return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment) {
+	return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment) {
+	return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+// The search only works in the buffers of its ThreadData, which are allocated with it.
+TEST(SearchAllocations, SearchingDoesNotAllocate) {
+	const auto state = chss::fen::Parse(kKiwipete);
+	auto stop = std::atomic_flag(false);
+	auto transpositionTable = chss::search::TranspositionTable(1);
+	auto threadData = chss::search::ThreadData{
+		.id = 0,
+		.transpositionTable = &transpositionTable,
+		.stop = &stop,
+		.nodes = 0};
+
+	const auto counter = AllocationCounter();
+	for (int depth = 1; depth <= 4; ++depth) {
+		std::ignore = chss::search::SearchRoot(state, depth, threadData);
+	}
+	std::ignore = chss::search::Search(state, 5, 0, -chss::search::kInfinity, chss::search::kInfinity, threadData);
+	EXPECT_GT(threadData.nodes.Get(), 1000);
+	EXPECT_EQ(counter.GetAllocations(), 0);
+}
+
+// The lines of the iterative deepening are allocated by the first search of the thread, and reused by the next ones.
+TEST(SearchAllocations, IterativeDeepeningDoesNotAllocateAfterTheFirstSearch) {
+	const auto state = chss::fen::Parse(kKiwipete);
+	auto stop = std::atomic_flag(false);
+	auto transpositionTable = chss::search::TranspositionTable(1);
+	auto threadData = chss::search::ThreadData{
+		.id = 0,
+		.transpositionTable = &transpositionTable,
+		.stop = &stop,
+		.nodes = 0,
+		.options = chss::search::SearchOptions{.multiPv = 3}};
+	std::ignore = chss::search::IterativeDeepening(state, 4, threadData);
+
+	const auto counter = AllocationCounter();
+	std::ignore = chss::search::IterativeDeepening(state, 5, threadData);
+	EXPECT_EQ(threadData.rootLines.size(), std::size_t{3});
+	EXPECT_EQ(counter.GetAllocations(), 0);
+}
+
+// The helper threads of the Lazy SMP search wait for the next search instead of getting a new task for each one.
+TEST(SearchAllocations, SearcherDoesNotAllocateAfterTheFirstSearch) {
+	const auto state = chss::fen::Parse(kKiwipete);
+	auto searcher = chss::search::Searcher(3);
+	searcher.SetOptions(chss::search::SearchOptions{.multiPv = 2});
+	searcher.SetGameKeys({1, 2, 3});
+	auto firstStop = std::atomic_flag(false);
+	std::ignore = searcher.Search(state, 4, firstStop);
+
+	const auto counter = AllocationCounter();
+	for (int i = 0; i < 3; ++i) {
+		auto stop = std::atomic_flag(false);
+		std::ignore = searcher.Search(state, 5, stop);
+	}
+	EXPECT_GT(searcher.GetNodes(), 1000);
+	EXPECT_EQ(counter.GetAllocations(), 0);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "chess/representation/Move.h"
+#include "chess/search/TranspositionTable.h"
+
+#include <cstdint>
+#include <span>
+
+namespace chss::search {
+
+/**
+ * A line of the iterative deepening that was searched to the end, or whose score fell outside of its aspiration
+ * window (then the score is only a bound).
+ */
+struct IterationReport {
+	int depth;
+	// Deepest ply that the iteration reached.
+	int selDepth;
+	// 1 for the best line, 2 for the second best one, ... (see SearchOptions::multiPv).
+	int multiPv;
+	int score;
+	Bound bound;
+	// Starts with the root move of the line. It is only valid during the call, and it can be cut short by transposition
+	// table cutoffs.
+	std::span<const Move> principalVariation;
+};
+
+/**
+ * A root move that the iteration starts to search.
+ */
+struct CurrentMoveReport {
+	int depth;
+	Move move;
+	// 1 for the first root move that the iteration searches, 2 for the second one, ...
+	int moveNumber;
+};
+
+// Nodes of the main thread between two calls to SearchReporter::ReportProgress.
+constexpr std::int64_t kProgressReportNodes = 4096;
+
+/**
+ * Receives the progress of a search from its main thread, while it searches. The calls come from the search thread,
+ * so they must be quick and must not touch the search.
+ */
+class SearchReporter {
+public:
+	virtual ~SearchReporter() = default;
+
+	virtual void ReportIteration(const IterationReport& report) = 0;
+
+	virtual void ReportCurrentMove(const CurrentMoveReport& report) = 0;
+
+	// For periodic updates (see kProgressReportNodes).
+	virtual void ReportProgress() = 0;
+};
+
+} // namespace chss::search
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "chess/MinMax.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+#include "chess/search/SearchReporter.h"
+#include "chess/search/ThreadData.h"
+#include "chess/search/TranspositionTable.h"
+#include "chess/search/Ybwc.h"
+
+#include <concurrency/TaskQueue.h>
+#include <concurrency/WorkerGroup.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace chss::search {
+
+enum class ParallelMode {
+	LazySMP,
+	YBWC,
+};
+
+/**
+ * Multithreaded search, in one of two modes:
+ * - Lazy SMP (default): all the threads run the iterative deepening on the same root position, sharing the
+ *   transposition table, and the helper threads skip some depths (see detail::IsDepthSkipped) so they do not duplicate
+ *   the work of the main thread. The result is the one of the main thread; the helpers only contribute through the
+ *   shared table.
+ * - YBWC: the tree is split between the threads (see YbwcSearch). It does not use the transposition table, so it is
+ *   weaker, but the result and the node count do not depend on the number of threads or on their timing.
+ *
+ * With SearchOptions::multiPv, the main thread of the Lazy SMP search finds that many best moves (see
+ * IterativeDeepening, and GetRootLines). The YBWC search only finds the best one.
+ *
+ * The helper threads and their data are created once (when the number of threads or the parallel mode changes) and
+ * reused by every search. The helpers of Lazy SMP wait between searches, and starting them does not allocate.
+ */
+class Searcher {
+public:
+	static constexpr int kMaxThreads = 512;
+	static constexpr std::size_t kDefaultHashSizeInMegaBytes = 16;
+
+	explicit Searcher(int numThreads = 1, std::size_t hashSizeInMegaBytes = kDefaultHashSizeInMegaBytes)
+		: mTranspositionTable(hashSizeInMegaBytes) {
+		SetNumThreads(numThreads);
+	}
+
+	Searcher(const Searcher&) = delete;
+	Searcher& operator=(const Searcher&) = delete;
+
+	// It must not be called while searching.
+	void SetNumThreads(int numThreads) {
+		assert(1 <= numThreads && numThreads <= kMaxThreads);
+		mHelpers.reset();
+		mTaskQueue.reset();
+		mThreadsData.clear();
+		for (int i = 0; i < numThreads; ++i) {
+			mThreadsData.push_back(std::make_unique<ThreadData>(ThreadData{.id = i}));
+		}
+		CreateHelpers();
+	}
+
+	[[nodiscard]] int GetNumThreads() const {
+		return static_cast<int>(mThreadsData.size());
+	}
+
+	// It must not be called while searching.
+	void SetParallelMode(ParallelMode parallelMode) {
+		if (parallelMode != mParallelMode) {
+			mParallelMode = parallelMode;
+			CreateHelpers();
+		}
+	}
+
+	[[nodiscard]] ParallelMode GetParallelMode() const {
+		return mParallelMode;
+	}
+
+	// It must not be called while searching.
+	void SetOptions(const SearchOptions& options) {
+		mOptions = options;
+	}
+
+	[[nodiscard]] const SearchOptions& GetOptions() const {
+		return mOptions;
+	}
+
+	// Zobrist keys of the positions of the game before the one to search, oldest first, to detect repetitions. Only the
+	// ones since the last irreversible move matter. It must not be called while searching.
+	void SetGameKeys(std::vector<std::uint64_t> gameKeys) {
+		mGameKeys = std::move(gameKeys);
+	}
+
+	// It must not be called while searching.
+	void SetHashSize(std::size_t sizeInMegaBytes) {
+		mTranspositionTable.Resize(sizeInMegaBytes);
+	}
+
+	// It must not be called while searching.
+	void Clear() {
+		mTranspositionTable.Clear();
+		for (auto& threadData : mThreadsData) {
+			threadData->histories->Clear();
+		}
+	}
+
+	/**
+	 * Searches until the main thread completes maxDepth or until stop is set. stop gets set when the search finishes,
+	 * to stop the helper threads.
+	 *
+	 * The main thread of the Lazy SMP search reports its progress to the reporter, if any. The YBWC search does not.
+	 */
+	[[nodiscard]] std::pair<int, Move> Search(
+		const State& state,
+		int maxDepth,
+		std::atomic_flag& stop,
+		SearchReporter* reporter = nullptr) {
+		for (auto& threadData : mThreadsData) {
+			threadData->options = mOptions;
+			threadData->stats = SearchStats();
+			threadData->gameKeys = mGameKeys;
+			threadData->rootPly = 0;
+			threadData->reporter = nullptr;
+		}
+		mYbwcNodes.reset();
+		if (mParallelMode == ParallelMode::YBWC) {
+			return SearchYbwc(state, maxDepth, stop);
+		}
+		mThreadsData[0]->reporter = reporter;
+		for (auto& threadData : mThreadsData) {
+			threadData->transpositionTable = &mTranspositionTable;
+			threadData->stop = &stop;
+			threadData->nodes = 0;
+		}
+		mHelpersState = &state;
+		mHelpersMaxDepth = maxDepth;
+		if (mHelpers != nullptr) {
+			mHelpers->Start();
+		}
+		const auto result = IterativeDeepening(state, maxDepth, *mThreadsData[0]);
+		stop.test_and_set();
+		if (mHelpers != nullptr) {
+			mHelpers->Wait();
+		}
+		return result;
+	}
+
+	// Best lines of the last search, best first.
+	[[nodiscard]] const std::vector<RootLine>& GetRootLines() const {
+		return mThreadsData[0]->rootLines;
+	}
+
+	// Principal variation of the line of the last search that starts with the given moves (see PrincipalVariation). In
+	// YBWC mode, which does not fill the transposition table, it is usually just the moves.
+	[[nodiscard]] std::vector<Move> GetPrincipalVariation(const State& state, std::span<const Move> firstMoves) const {
+		return PrincipalVariation(state, firstMoves, mTranspositionTable);
+	}
+
+	[[nodiscard]] std::vector<Move> GetPrincipalVariation(const State& state, const Move& firstMove) const {
+		return PrincipalVariation(state, firstMove, mTranspositionTable);
+	}
+
+	// Permille of the transposition table in use.
+	[[nodiscard]] int GetHashFull() const {
+		return mTranspositionTable.HashFull();
+	}
+
+	// Nodes visited by all the threads in the last search, or so far in the current one (Lazy SMP only).
+	[[nodiscard]] std::int64_t GetNodes() const {
+		if (mYbwcNodes.has_value()) {
+			return mYbwcNodes.value();
+		}
+		return std::accumulate(
+			mThreadsData.begin(),
+			mThreadsData.end(),
+			std::int64_t{0},
+			[](std::int64_t nodes, const auto& threadData) { return nodes + threadData->nodes.Get(); });
+	}
+
+	// Stats of all the threads in the last search.
+	[[nodiscard]] SearchStats GetStats() const {
+		auto stats = SearchStats();
+		for (const auto& threadData : mThreadsData) {
+			stats += threadData->stats;
+		}
+		return stats;
+	}
+
+private:
+	// The helper threads of the parallel mode: the workers that run the iterative deepening of Lazy SMP with the
+	// ThreadData after the main one, or the TaskQueue that YBWC offers its young brothers to.
+	void CreateHelpers() {
+		mHelpers.reset();
+		mTaskQueue.reset();
+		const auto numHelpers = GetNumThreads() - 1;
+		if (numHelpers == 0) {
+			return;
+		}
+		if (mParallelMode == ParallelMode::YBWC) {
+			mTaskQueue = std::make_unique<concurrency::TaskQueue>(numHelpers);
+			return;
+		}
+		mHelpers = std::make_unique<concurrency::WorkerGroup>(numHelpers, [this](const int index) {
+			const auto& threadData = mThreadsData[static_cast<std::size_t>(index) + 1];
+			[[maybe_unused]] const auto result = IterativeDeepening(*mHelpersState, mHelpersMaxDepth, *threadData);
+		});
+	}
+
+	[[nodiscard]] std::pair<int, Move> SearchYbwc(const State& state, int maxDepth, std::atomic_flag& stop) {
+		auto threadsData = std::vector<ThreadData*>();
+		for (auto& threadData : mThreadsData) {
+			threadData->options.updateHistories = false;
+			threadData->histories->Clear();
+			threadsData.push_back(threadData.get());
+		}
+		auto context = YbwcContext(mTaskQueue.get(), threadsData, stop);
+		const auto [result, move] = YbwcIterativeDeepening(state, maxDepth, context);
+		stop.test_and_set();
+		context.WaitForTasks();
+		mYbwcNodes = result.nodes;
+		auto line = RootLine{.score = result.score, .move = move};
+		line.principalVariation.PushBack(move);
+		mThreadsData[0]->rootLines = {line};
+		return std::pair<int, Move>(result.score, move);
+	}
+
+	ParallelMode mParallelMode = ParallelMode::LazySMP;
+	SearchOptions mOptions;
+	std::vector<std::uint64_t> mGameKeys;
+	std::optional<std::int64_t> mYbwcNodes;
+	TranspositionTable mTranspositionTable;
+	std::vector<std::unique_ptr<ThreadData>> mThreadsData;
+	std::unique_ptr<concurrency::TaskQueue> mTaskQueue;
+	// The position and depth of the current search, for the helpers of Lazy SMP.
+	const State* mHelpersState = nullptr;
+	int mHelpersMaxDepth = 0;
+	std::unique_ptr<concurrency::WorkerGroup> mHelpers;
+};
+
+} // namespace chss::search
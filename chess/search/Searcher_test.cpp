@@ -0,0 +1,247 @@
+#include "Searcher.h"
+
+#include "chess/fen/Fen.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+TEST(Searcher, MateInTwo_SingleThread) {
+	auto searcher = chss::search::Searcher(1);
+	auto stop = std::atomic_flag(false);
+	const auto [score, move] = searcher.Search(chss::fen::Parse("7K/8/8/8/6R1/7R/1k6/8 w - - 0 1"), 4, stop);
+	EXPECT_EQ(score, chss::search::MateIn(3));
+	EXPECT_GT(searcher.GetNodes(), 0);
+}
+
+TEST(Searcher, MateInTwo_LazySMP) {
+	auto searcher = chss::search::Searcher(4);
+	auto stop = std::atomic_flag(false);
+	const auto [score, move] = searcher.Search(chss::fen::Parse("7K/8/8/8/6R1/7R/1k6/8 w - - 0 1"), 4, stop);
+	EXPECT_EQ(score, chss::search::MateIn(3));
+	EXPECT_TRUE(stop.test());
+}
+
+TEST(Searcher, ReusesThreadsAcrossSearches) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto searcher = chss::search::Searcher(3);
+	for (int i = 0; i < 3; ++i) {
+		auto stop = std::atomic_flag(false);
+		const auto [score, move] = searcher.Search(state, 3, stop);
+		EXPECT_EQ(searcher.GetNumThreads(), 3);
+		EXPECT_NE(move, chss::search::kNoMove);
+	}
+	searcher.SetNumThreads(2);
+	auto stop = std::atomic_flag(false);
+	const auto [score, move] = searcher.Search(state, 3, stop);
+	EXPECT_NE(move, chss::search::kNoMove);
+}
+
+TEST(Searcher, PrincipalVariationStartsWithTheBestMove) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto searcher = chss::search::Searcher(1);
+	auto stop = std::atomic_flag(false);
+	const auto [score, move] = searcher.Search(state, 4, stop);
+	const auto principalVariation = searcher.GetPrincipalVariation(state, move);
+	ASSERT_GE(principalVariation.size(), std::size_t{2});
+	EXPECT_EQ(principalVariation.front(), move);
+}
+
+// What a ponder search learns is kept for the search that follows it.
+TEST(Searcher, KeepsTheTranspositionTableBetweenSearches) {
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto searcher = chss::search::Searcher(1);
+	auto firstStop = std::atomic_flag(false);
+	const auto firstResult = searcher.Search(state, 4, firstStop);
+	const auto firstNodes = searcher.GetNodes();
+	auto secondStop = std::atomic_flag(false);
+	const auto secondResult = searcher.Search(state, 4, secondStop);
+	EXPECT_LT(searcher.GetNodes(), firstNodes);
+	EXPECT_EQ(secondResult.second, firstResult.second);
+}
+
+namespace {
+
+class RecordingReporter final : public chss::search::SearchReporter {
+public:
+	void ReportIteration(const chss::search::IterationReport& report) override {
+		iterations.push_back(report);
+		// The principal variation is only valid during the call.
+		iterations.back().principalVariation = {};
+		principalVariations.emplace_back(report.principalVariation.begin(), report.principalVariation.end());
+	}
+
+	void ReportCurrentMove(const chss::search::CurrentMoveReport& report) override {
+		currentMoves.push_back(report);
+	}
+
+	void ReportProgress() override {
+		++progressReports;
+	}
+
+	std::vector<chss::search::IterationReport> iterations;
+	std::vector<std::vector<chss::Move>> principalVariations;
+	std::vector<chss::search::CurrentMoveReport> currentMoves;
+	int progressReports = 0;
+};
+
+} // namespace
+
+TEST(Searcher, ReportsEachIterationAndRootMove) {
+	// Deep enough to visit more than kProgressReportNodes nodes.
+	constexpr auto kDepth = 5;
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto searcher = chss::search::Searcher(1);
+	auto reporter = RecordingReporter();
+	auto stop = std::atomic_flag(false);
+	const auto [score, move] = searcher.Search(state, kDepth, stop, &reporter);
+
+	auto exactIterations = std::vector<chss::search::IterationReport>();
+	auto lastPrincipalVariation = std::vector<chss::Move>();
+	for (std::size_t i = 0; i < reporter.iterations.size(); ++i) {
+		if (reporter.iterations[i].bound == chss::search::Bound::Exact) {
+			exactIterations.push_back(reporter.iterations[i]);
+			lastPrincipalVariation = reporter.principalVariations[i];
+		}
+	}
+	ASSERT_EQ(exactIterations.size(), static_cast<std::size_t>(kDepth));
+	for (int i = 0; i < kDepth; ++i) {
+		EXPECT_EQ(exactIterations[i].depth, i + 1);
+		EXPECT_EQ(exactIterations[i].multiPv, 1);
+		EXPECT_GE(exactIterations[i].selDepth, exactIterations[i].depth);
+	}
+	EXPECT_EQ(exactIterations.back().score, score);
+	ASSERT_FALSE(lastPrincipalVariation.empty());
+	EXPECT_EQ(lastPrincipalVariation.front(), move);
+
+	ASSERT_FALSE(reporter.currentMoves.empty());
+	EXPECT_EQ(reporter.currentMoves.front().depth, 1);
+	EXPECT_EQ(reporter.currentMoves.front().moveNumber, 1);
+	EXPECT_GT(reporter.progressReports, 0);
+	EXPECT_LE(reporter.progressReports, searcher.GetNodes() / chss::search::kProgressReportNodes);
+}
+
+// The helpers can fill the transposition table so fast that the tree of the main thread is cut short, so only what does
+// not depend on the timing of the threads is checked.
+TEST(Searcher, OnlyTheMainThreadReports) {
+	constexpr auto kDepth = 5;
+	const auto state = chss::fen::Parse("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+	auto searcher = chss::search::Searcher(2);
+	auto reporter = RecordingReporter();
+	auto stop = std::atomic_flag(false);
+	[[maybe_unused]] const auto result = searcher.Search(state, kDepth, stop, &reporter);
+
+	auto exactDepths = std::vector<int>();
+	for (const auto& iteration : reporter.iterations) {
+		if (iteration.bound == chss::search::Bound::Exact) {
+			exactDepths.push_back(iteration.depth);
+		}
+	}
+	EXPECT_EQ(exactDepths, (std::vector<int>{1, 2, 3, 4, 5}));
+	EXPECT_LT(reporter.progressReports, searcher.GetNodes() / chss::search::kProgressReportNodes + 1);
+}
+
+// Time to depth of the Lazy SMP search with 1, 2, 4, 8 and 16 threads. Run it with --gtest_also_run_disabled_tests.
+TEST(Searcher, DISABLED_TimeToDepth) {
+	constexpr auto kDepth = 5;
+	const auto fens = std::array<std::string_view, 3>{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"};
+	for (const auto numThreads : {1, 2, 4, 8, 16}) {
+		auto searcher = chss::search::Searcher(numThreads);
+		auto totalTime = std::chrono::milliseconds(0);
+		std::int64_t totalNodes = 0;
+		for (const auto fen : fens) {
+			searcher.Clear();
+			auto stop = std::atomic_flag(false);
+			const auto start = std::chrono::steady_clock::now();
+			[[maybe_unused]] const auto result = searcher.Search(chss::fen::Parse(fen), kDepth, stop);
+			totalTime +=
+				std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+			totalNodes += searcher.GetNodes();
+		}
+		std::cout << "threads " << numThreads << " depth " << kDepth << " time " << totalTime.count() << "ms nodes "
+				  << totalNodes << std::endl;
+	}
+}
+
+// Nodes and aspiration window failures with and without aspiration windows. Run it with
+// --gtest_also_run_disabled_tests.
+TEST(Searcher, DISABLED_AspirationWindowNodes) {
+	constexpr auto kDepth = 5;
+	const auto fens = std::array<std::string_view, 3>{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"};
+	for (const auto useAspirationWindows : {false, true}) {
+		auto searcher = chss::search::Searcher(1);
+		searcher.SetOptions(chss::search::SearchOptions{.useAspirationWindows = useAspirationWindows});
+		for (const auto fen : fens) {
+			searcher.Clear();
+			auto stop = std::atomic_flag(false);
+			[[maybe_unused]] const auto result = searcher.Search(chss::fen::Parse(fen), kDepth, stop);
+			const auto stats = searcher.GetStats();
+			std::cout << "aspiration " << useAspirationWindows << " nodes " << searcher.GetNodes() << " fail highs "
+					  << stats.aspirationFailHighs << " fail lows " << stats.aspirationFailLows << " re-searches "
+					  << stats.pvsReSearches << " " << fen << std::endl;
+		}
+	}
+}
+
+TEST(Searcher, DISABLED_InternalIterationNodes) {
+	constexpr auto kDepth = 7;
+	const auto fens = std::array<std::string_view, 4>{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		"r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 1"};
+	for (const auto internalIteration :
+		 {chss::search::InternalIteration::None,
+		  chss::search::InternalIteration::Reductions,
+		  chss::search::InternalIteration::Deepening}) {
+		auto searcher = chss::search::Searcher(1);
+		searcher.SetOptions(chss::search::SearchOptions{.internalIteration = internalIteration});
+		std::int64_t totalNodes = 0;
+		for (const auto fen : fens) {
+			searcher.Clear();
+			auto stop = std::atomic_flag(false);
+			[[maybe_unused]] const auto result = searcher.Search(chss::fen::Parse(fen), kDepth, stop);
+			const auto stats = searcher.GetStats();
+			totalNodes += searcher.GetNodes();
+			std::cout << "internal iteration " << static_cast<int>(internalIteration) << " nodes "
+					  << searcher.GetNodes() << " reductions " << stats.internalIterativeReductions << " deepenings "
+					  << stats.internalIterativeDeepenings << " " << fen << std::endl;
+		}
+		std::cout << "internal iteration " << static_cast<int>(internalIteration) << " total nodes " << totalNodes
+				  << std::endl;
+	}
+}
+
+// Speed of the single-threaded search, in nodes per second, to compare versions of the search on the same nodes (such
+// as the node type instantiations of SearchNode against a search that tests the node type at run time). Build it with
+// optimizations and run it with --gtest_also_run_disabled_tests.
+TEST(Searcher, DISABLED_NodesPerSecond) {
+	constexpr auto kDepth = 8;
+	const auto fens = std::array<std::string_view, 4>{
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+		"r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1B1PPP/R2QKB1R w KQ - 0 1"};
+	auto searcher = chss::search::Searcher(1);
+	auto totalTime = std::chrono::milliseconds(0);
+	std::int64_t totalNodes = 0;
+	for (const auto fen : fens) {
+		searcher.Clear();
+		auto stop = std::atomic_flag(false);
+		const auto start = std::chrono::steady_clock::now();
+		[[maybe_unused]] const auto result = searcher.Search(chss::fen::Parse(fen), kDepth, stop);
+		totalTime += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+		totalNodes += searcher.GetNodes();
+	}
+	std::cout << "depth " << kDepth << " time " << totalTime.count() << "ms nodes " << totalNodes << " nps "
+			  << totalNodes * 1000 / std::max<std::int64_t>(totalTime.count(), 1) << std::endl;
+}
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "chess/representation/Move.h"
+#include "chess/search/History.h"
+#include "chess/search/SearchReporter.h"
+#include "chess/search/TranspositionTable.h"
+
+#include <cpp_utils/StaticVector.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace chss::search {
+
+// No position has more legal moves than this (the known maximum is 218).
+constexpr std::size_t kMaxMoves = 256;
+
+using MoveList = cpp_utils::StaticVector<Move, kMaxMoves>;
+
+/**
+ * Cancellation of a subtree of a split search. A subtree is cancelled when its own token or the token of any split
+ * point above it is cancelled.
+ */
+struct CancellationToken {
+	std::atomic<bool> isCancelled = false;
+	const CancellationToken* parent = nullptr;
+
+	[[nodiscard]] bool IsCancelled() const {
+		for (const auto* token = this; token != nullptr; token = token->parent) {
+			if (token->isCancelled.load(std::memory_order_relaxed)) {
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+/**
+ * Counter that only its own thread increments, and that other threads can read while it runs (to report the nodes of
+ * all the threads). The relaxed load and store cost the same as a plain increment, unlike an atomic read-modify-write.
+ */
+class NodeCounter {
+public:
+	NodeCounter(const std::int64_t value = 0)
+		: mValue(value) {}
+
+	NodeCounter(const NodeCounter& other)
+		: mValue(other.Get()) {}
+
+	NodeCounter& operator=(const NodeCounter& other) {
+		mValue.store(other.Get(), std::memory_order_relaxed);
+		return *this;
+	}
+
+	NodeCounter& operator++() {
+		mValue.store(Get() + 1, std::memory_order_relaxed);
+		return *this;
+	}
+
+	[[nodiscard]] std::int64_t Get() const {
+		return mValue.load(std::memory_order_relaxed);
+	}
+
+	operator std::int64_t() const {
+		return Get();
+	}
+
+private:
+	std::atomic<std::int64_t> mValue;
+};
+
+/**
+ * Margins of the forward pruning near the leaves, indexed by the remaining depth (index 0 is not used).
+ */
+struct PruningMargins {
+	// Nodes whose static evaluation is above beta by more than this are pruned (reverse futility pruning).
+	std::array<int, 4> reverseFutility = {0, 100, 200, 300};
+	// Quiet moves are not searched if the static evaluation plus this does not reach alpha (futility pruning).
+	std::array<int, 4> futility = {0, 150, 300, 450};
+	// Nodes whose static evaluation plus this does not reach alpha are resolved by the quiescence search (razoring).
+	std::array<int, 4> razoring = {0, 300, 550, 800};
+	// Quiet moves after this many moves are not searched (late-move pruning).
+	std::array<int, 4> lateMovePruningCounts = {0, 12, 18, 26};
+};
+
+/**
+ * What the search does at PV and cut nodes that have no transposition table move to try first.
+ */
+enum class InternalIteration {
+	// Nothing: the moves are tried in their default order.
+	None,
+	// Internal iterative reductions: the node is searched one ply shallower (it is likely to be a bad node, or a new
+	// one whose result is not worth much depth).
+	Reductions,
+	// Internal iterative deepening: a shallower search of the node finds a move to try first.
+	Deepening,
+};
+
+/**
+ * Switches of the search features, so their effect can be compared.
+ */
+struct SearchOptions {
+	bool useAspirationWindows = true;
+	bool useNullMovePruning = true;
+	bool useLateMoveReductions = true;
+	bool useFrontierPruning = true;
+	bool useExtensions = true;
+	bool useProbCut = true;
+	// ProbCut does not prune, it only counts how often its prediction holds (see SearchStats::probCutConfirmed).
+	bool verifyProbCut = false;
+	bool useMateDistancePruning = true;
+	InternalIteration internalIteration = InternalIteration::Reductions;
+	// Number of best root moves that the iterative deepening finds, each with its own score (MultiPV).
+	int multiPv = 1;
+	PruningMargins pruningMargins = PruningMargins();
+	// Whether the beta cutoffs update the histories (see HistoryTables). Without it, the histories keep their content,
+	// so the move ordering, and the result, only depend on the node and not on the searches before it.
+	bool updateHistories = true;
+};
+
+/**
+ * Counters of what the search did, besides visiting nodes.
+ */
+struct SearchStats {
+	// Iterations of the iterative deepening that had to be repeated because the score fell outside the aspiration
+	// window.
+	std::int64_t aspirationFailHighs = 0;
+	std::int64_t aspirationFailLows = 0;
+	// Null-window scouts of the principal variation search that failed high and had to be searched again.
+	std::int64_t pvsReSearches = 0;
+	// Null-move searches tried, and how many of them failed high and pruned the node.
+	std::int64_t nullMoveTries = 0;
+	std::int64_t nullMoveCutoffs = 0;
+	// Reduced searches of late moves, and how many of them failed high and had to be searched again at full depth.
+	std::int64_t lateMoveReductions = 0;
+	std::int64_t lateMoveReSearches = 0;
+	// Nodes and moves pruned by the frontier pruning (see PruningMargins).
+	std::int64_t reverseFutilityPrunes = 0;
+	std::int64_t razoringPrunes = 0;
+	std::int64_t futilityPrunes = 0;
+	std::int64_t lateMovePrunes = 0;
+	std::int64_t quiescenceNodes = 0;
+	// Moves searched one ply deeper because they give check, or because they are singular (the only good move).
+	std::int64_t checkExtensions = 0;
+	std::int64_t singularSearches = 0;
+	std::int64_t singularExtensions = 0;
+	// Nodes where ProbCut was tried, and where its shallow search predicted a fail high. With
+	// SearchOptions::verifyProbCut, probCutConfirmed counts the predictions that the full search confirmed.
+	std::int64_t probCutTries = 0;
+	std::int64_t probCutCutoffs = 0;
+	std::int64_t probCutConfirmed = 0;
+	// Nodes without a transposition table move that were reduced, or searched first at a shallower depth (see
+	// InternalIteration).
+	std::int64_t internalIterativeReductions = 0;
+	std::int64_t internalIterativeDeepenings = 0;
+
+	SearchStats& operator+=(const SearchStats& other) {
+		aspirationFailHighs += other.aspirationFailHighs;
+		aspirationFailLows += other.aspirationFailLows;
+		pvsReSearches += other.pvsReSearches;
+		nullMoveTries += other.nullMoveTries;
+		nullMoveCutoffs += other.nullMoveCutoffs;
+		lateMoveReductions += other.lateMoveReductions;
+		lateMoveReSearches += other.lateMoveReSearches;
+		reverseFutilityPrunes += other.reverseFutilityPrunes;
+		razoringPrunes += other.razoringPrunes;
+		futilityPrunes += other.futilityPrunes;
+		lateMovePrunes += other.lateMovePrunes;
+		quiescenceNodes += other.quiescenceNodes;
+		checkExtensions += other.checkExtensions;
+		singularSearches += other.singularSearches;
+		singularExtensions += other.singularExtensions;
+		probCutTries += other.probCutTries;
+		probCutCutoffs += other.probCutCutoffs;
+		probCutConfirmed += other.probCutConfirmed;
+		internalIterativeReductions += other.internalIterativeReductions;
+		internalIterativeDeepenings += other.internalIterativeDeepenings;
+		return *this;
+	}
+};
+
+// Deepest ply that the search reaches, extensions included.
+constexpr int kMaxPly = 128;
+
+// Moves from a ply to the end of the principal variation below it.
+using PrincipalVariationLine = cpp_utils::StaticVector<Move, kMaxPly + 1>;
+
+/**
+ * What the search keeps for each ply of the current path. Besides the state of the node, it holds the buffers that the
+ * node needs (its moves, and the moves it already tried), so that the search does not allocate and keeps its C++ stack
+ * frames small.
+ */
+struct SearchStackEntry {
+	// Zobrist key of the position at this ply, to detect repetitions.
+	std::uint64_t key = 0;
+	// Move that the node must not search (set during the exclusion search of a singular extension).
+	std::optional<Move> excludedMove;
+	// Whether the move being searched from this ply is a null move.
+	bool isNullMove = false;
+	// Plies added by extensions on the path from the root to this ply.
+	int extensions = 0;
+	// Whether the node at this ply is expected to fail high (a null-window node whose parent expects it to refute the
+	// move that led to it).
+	bool isCutNode = false;
+	// Piece and destination of the move being searched from this ply (none for null moves), which index the
+	// continuation history and the counter moves of the plies below.
+	std::optional<PieceToSquare> pieceToSquare;
+	// Principal variation of the node, set by PV nodes.
+	PrincipalVariationLine principalVariation;
+	// Legal moves of the node in search order, with their ordering scores, and the quiet moves and captures that it
+	// searched so far. They are only valid while the node is being searched.
+	MoveList moves;
+	std::array<int, kMaxMoves> moveScores;
+	MoveList quietMoves;
+	MoveList captureMoves;
+
+	// Forgets the node that was at this ply. The buffers are not touched, since every node fills them before reading.
+	void Reset() {
+		key = 0;
+		excludedMove = std::nullopt;
+		isNullMove = false;
+		extensions = 0;
+		isCutNode = false;
+		pieceToSquare = std::nullopt;
+		principalVariation.Clear();
+	}
+};
+
+/**
+ * The entries of the search stack, one per ply. At about 18 KB each, they are too big for the stack of a thread, so
+ * each thread allocates them once, with its ThreadData, and reuses them in every search.
+ */
+class SearchStack {
+public:
+	SearchStack()
+		: mEntries(std::make_unique<std::array<SearchStackEntry, kMaxPly + 1>>()) {}
+
+	[[nodiscard]] SearchStackEntry& operator[](const int ply) {
+		return (*mEntries)[static_cast<std::size_t>(ply)];
+	}
+
+	[[nodiscard]] const SearchStackEntry& operator[](const int ply) const {
+		return (*mEntries)[static_cast<std::size_t>(ply)];
+	}
+
+	void Reset() {
+		for (auto& entry : *mEntries) {
+			entry.Reset();
+		}
+	}
+
+	// Resets the plies from fromPly to toPly, both included.
+	void Reset(const int fromPly, const int toPly) {
+		for (int ply = fromPly; ply <= toPly; ++ply) {
+			(*this)[ply].Reset();
+		}
+	}
+
+private:
+	std::unique_ptr<std::array<SearchStackEntry, kMaxPly + 1>> mEntries;
+};
+
+/**
+ * One of the best lines of an iteration of the iterative deepening.
+ */
+struct RootLine {
+	int score = 0;
+	Move move = Move{};
+	// Starts with move. It can be cut short by transposition table cutoffs.
+	PrincipalVariationLine principalVariation = {};
+};
+
+/**
+ * Everything a search thread owns or shares with the others while exploring the tree.
+ */
+struct ThreadData {
+	int id = 0;
+	TranspositionTable* transpositionTable = nullptr;
+	std::atomic_flag* stop = nullptr;
+	const CancellationToken* cancellation = nullptr;
+	NodeCounter nodes = 0;
+	// Deepest ply reached by the current iteration of the iterative deepening.
+	int selDepth = 0;
+	// Only the main thread of a search reports its progress.
+	SearchReporter* reporter = nullptr;
+	SearchOptions options = SearchOptions();
+	SearchStats stats = SearchStats();
+	// Allocated once per thread, when the ThreadData is created.
+	std::unique_ptr<HistoryTables> histories = std::make_unique<HistoryTables>();
+	SearchStack stack = SearchStack();
+	// Zobrist keys of the positions of the game before the root, oldest first. Together with the keys of the search
+	// stack, they are the history of the positions of each node.
+	std::vector<std::uint64_t> gameKeys = {};
+	// Ply of the root of the search, whose path starts there: the plies of the stack below it are not looked at for
+	// repetitions, and gameKeys come right before it. It is 0 except in the serial searches of YBWC.
+	int rootPly = 0;
+	// Best lines of the last iteration of the iterative deepening, best first (see SearchOptions::multiPv), and the
+	// ones of the iteration in progress. The iterations swap them, so they only allocate when there are more lines.
+	std::vector<RootLine> rootLines = {};
+	std::vector<RootLine> iterationLines = {};
+
+	[[nodiscard]] bool IsStopped() const {
+		return stop->test() || (cancellation != nullptr && cancellation->IsCancelled());
+	}
+};
+
+} // namespace chss::search
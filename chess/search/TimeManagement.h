@@ -0,0 +1,60 @@
+#pragma once
+
+#include "chess/representation/Piece.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <optional>
+
+namespace chss::search {
+
+/**
+ * Limits of a search, as given by the UCI "go" command.
+ */
+struct SearchLimits {
+	std::optional<int> depth = std::nullopt;
+	// Remaining time and increment per move of each side, indexed by Color.
+	std::array<std::optional<std::chrono::milliseconds>, 2> time = {};
+	std::array<std::chrono::milliseconds, 2> increment = {};
+	std::optional<int> movesToGo = std::nullopt;
+	std::optional<std::chrono::milliseconds> moveTime = std::nullopt;
+	// Search until stopped.
+	bool infinite = false;
+	// Search on the expected reply of the opponent, until "ponderhit" (then the time limits apply) or "stop".
+	bool ponder = false;
+};
+
+// Moves left in the game when the time control does not tell.
+constexpr int kDefaultMovesToGo = 30;
+// Time kept in reserve for the communication with the GUI.
+constexpr auto kMoveOverhead = std::chrono::milliseconds(20);
+
+/**
+ * Time to spend on a move of the given side, or nothing if the search has no time limit. It is an even share of the
+ * remaining time among the moves to go, plus most of the increment, and never more than the remaining time minus
+ * kMoveOverhead.
+ */
+[[nodiscard]] constexpr std::optional<std::chrono::milliseconds> AllocateTime(
+	const SearchLimits& limits,
+	const Color color) {
+	if (limits.infinite) {
+		return std::nullopt;
+	}
+	if (limits.moveTime.has_value()) {
+		return std::max(limits.moveTime.value() - kMoveOverhead, std::chrono::milliseconds(1));
+	}
+	const auto colorIndex = static_cast<std::size_t>(color);
+	if (!limits.time[colorIndex].has_value()) {
+		return std::nullopt;
+	}
+	const auto time = limits.time[colorIndex].value();
+	const auto movesToGo = std::max(limits.movesToGo.value_or(kDefaultMovesToGo), 1);
+	const auto share = time / movesToGo + limits.increment[colorIndex] * 3 / 4;
+	return std::clamp(
+		share,
+		std::chrono::milliseconds(1),
+		std::max(time - kMoveOverhead, std::chrono::milliseconds(1)));
+}
+
+} // namespace chss::search
@@ -0,0 +1,40 @@
+#include "TimeManagement.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto kSuddenDeath = chss::search::SearchLimits{.time = {60000ms, 30000ms}, .increment = {1000ms, 0ms}};
+
+} // namespace
+
+TEST_CASE("TimeManagement", "ShareOfTheRemainingTimePlusIncrement") {
+	STATIC_REQUIRE(chss::search::AllocateTime(kSuddenDeath, chss::Color::White) == 60000ms / 30 + 750ms);
+	STATIC_REQUIRE(chss::search::AllocateTime(kSuddenDeath, chss::Color::Black) == 1000ms);
+	STATIC_REQUIRE(
+		chss::search::AllocateTime(
+			chss::search::SearchLimits{.time = {10000ms, 10000ms}, .movesToGo = 5}, chss::Color::Black) == 2000ms);
+}
+
+TEST_CASE("TimeManagement", "NeverMoreThanTheRemainingTime") {
+	STATIC_REQUIRE(
+		chss::search::AllocateTime(
+			chss::search::SearchLimits{.time = {500ms, 500ms}, .increment = {2000ms, 2000ms}}, chss::Color::White) ==
+		500ms - chss::search::kMoveOverhead);
+	STATIC_REQUIRE(
+		chss::search::AllocateTime(chss::search::SearchLimits{.time = {5ms, 5ms}}, chss::Color::White) == 1ms);
+}
+
+TEST_CASE("TimeManagement", "MoveTimeInfiniteAndDepth") {
+	STATIC_REQUIRE(
+		chss::search::AllocateTime(chss::search::SearchLimits{.moveTime = 1000ms}, chss::Color::White) ==
+		1000ms - chss::search::kMoveOverhead);
+	STATIC_REQUIRE(
+		!chss::search::AllocateTime(chss::search::SearchLimits{.time = {60000ms, 60000ms}, .infinite = true},
+			chss::Color::White).has_value());
+	STATIC_REQUIRE(!chss::search::AllocateTime(chss::search::SearchLimits{.depth = 5}, chss::Color::White).has_value());
+}
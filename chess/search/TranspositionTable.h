@@ -0,0 +1,159 @@
+#pragma once
+
+#include "chess/representation/Move.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace chss::search {
+
+enum class Bound : std::uint8_t { None, Upper, Lower, Exact };
+
+struct TranspositionTableEntry {
+	int depth;
+	int score;
+	Bound bound;
+	std::optional<Move> move;
+};
+
+} // namespace chss::search
+
+namespace detail {
+
+// 6 bits from, 6 bits to, 3 bits promotion type. 0 means "no move" (a1a1 is never a move).
+[[nodiscard]] constexpr std::uint64_t EncodeMove(const std::optional<chss::Move>& moveOpt) {
+	if (!moveOpt.has_value()) {
+		return 0;
+	}
+	const auto& move = moveOpt.value();
+	const auto from = static_cast<std::uint64_t>(move.from.y * 8 + move.from.x);
+	const auto to = static_cast<std::uint64_t>(move.to.y * 8 + move.to.x);
+	const auto promotion = move.promotionType.has_value() ? static_cast<std::uint64_t>(move.promotionType.value()) : 0;
+	return from | (to << 6) | (promotion << 12);
+}
+
+[[nodiscard]] constexpr std::optional<chss::Move> DecodeMove(const std::uint64_t bits) {
+	if (bits == 0) {
+		return std::nullopt;
+	}
+	const auto from = static_cast<int>(bits & 63);
+	const auto to = static_cast<int>((bits >> 6) & 63);
+	const auto promotion = static_cast<int>((bits >> 12) & 7);
+	return chss::Move{
+		.from = chss::Position{.y = from / 8, .x = from % 8},
+		.to = chss::Position{.y = to / 8, .x = to % 8},
+		.promotionType =
+			promotion == 0 ? std::nullopt : std::optional<chss::PieceType>(static_cast<chss::PieceType>(promotion))};
+}
+
+// Bits 0-15 move, 16-31 score, 32-39 depth, 40-41 bound.
+[[nodiscard]] constexpr std::uint64_t EncodeEntry(const chss::search::TranspositionTableEntry& entry) {
+	const auto score = static_cast<std::uint64_t>(static_cast<std::uint16_t>(static_cast<std::int16_t>(entry.score)));
+	const auto depth = static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.depth));
+	const auto bound = static_cast<std::uint64_t>(entry.bound);
+	return EncodeMove(entry.move) | (score << 16) | (depth << 32) | (bound << 40);
+}
+
+[[nodiscard]] constexpr chss::search::TranspositionTableEntry DecodeEntry(const std::uint64_t data) {
+	return chss::search::TranspositionTableEntry{
+		.depth = static_cast<int>(static_cast<std::uint8_t>(data >> 32)),
+		.score = static_cast<int>(static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> 16))),
+		.bound = static_cast<chss::search::Bound>((data >> 40) & 3),
+		.move = DecodeMove(data & 0xFFFF)};
+}
+
+} // namespace detail
+
+namespace chss::search {
+
+/**
+ * Hash table of search results shared by all the search threads.
+ *
+ * It is lock-less: every slot stores the key xor-ed with the data, so an entry that was torn by two threads writing
+ * at the same time does not match its key anymore and is just treated as a miss.
+ */
+class TranspositionTable {
+public:
+	explicit TranspositionTable(std::size_t sizeInMegaBytes) {
+		Resize(sizeInMegaBytes);
+	}
+
+	TranspositionTable(const TranspositionTable&) = delete;
+	TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+	// Drops all the entries. It must not be called while searching.
+	void Resize(std::size_t sizeInMegaBytes) {
+		const auto numSlots = std::bit_floor(std::max<std::size_t>(1, sizeInMegaBytes * 1024 * 1024 / sizeof(Slot)));
+		mSlots = std::make_unique<Slot[]>(numSlots);
+		mMask = numSlots - 1;
+	}
+
+	// It must not be called while searching.
+	void Clear() {
+		for (std::size_t i = 0; i <= mMask; ++i) {
+			mSlots[i].keyXorData.store(0, std::memory_order_relaxed);
+			mSlots[i].data.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	// Permille of the slots in use, estimated from the first thousand of them (for the UCI "hashfull").
+	[[nodiscard]] int HashFull() const {
+		const auto numSamples = std::min<std::size_t>(1000, mMask + 1);
+		std::size_t used = 0;
+		for (std::size_t i = 0; i < numSamples; ++i) {
+			used += mSlots[i].data.load(std::memory_order_relaxed) != 0 ? 1 : 0;
+		}
+		return static_cast<int>(used * 1000 / numSamples);
+	}
+
+	[[nodiscard]] std::optional<TranspositionTableEntry> Probe(const std::uint64_t key) const {
+		const auto& slot = mSlots[key & mMask];
+		const auto keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+		const auto data = slot.data.load(std::memory_order_relaxed);
+		if ((keyXorData ^ data) != key || data == 0) {
+			return std::nullopt;
+		}
+		return detail::DecodeEntry(data);
+	}
+
+	void Store(const std::uint64_t key, const TranspositionTableEntry& entry) {
+		auto& slot = mSlots[key & mMask];
+		const auto oldKeyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+		const auto oldData = slot.data.load(std::memory_order_relaxed);
+		if ((oldKeyXorData ^ oldData) == key) {
+			const auto oldEntry = detail::DecodeEntry(oldData);
+			// Keep deeper results of the same position, unless the new one is exact.
+			if (entry.bound != Bound::Exact && entry.depth < oldEntry.depth) {
+				return;
+			}
+			// Keep the move of a previous search if the new result does not have one.
+			if (!entry.move.has_value() && oldEntry.move.has_value()) {
+				auto newEntry = entry;
+				newEntry.move = oldEntry.move;
+				Write(slot, key, detail::EncodeEntry(newEntry));
+				return;
+			}
+		}
+		Write(slot, key, detail::EncodeEntry(entry));
+	}
+
+private:
+	struct Slot {
+		std::atomic<std::uint64_t> keyXorData;
+		std::atomic<std::uint64_t> data;
+	};
+
+	static void Write(Slot& slot, const std::uint64_t key, const std::uint64_t data) {
+		slot.keyXorData.store(key ^ data, std::memory_order_relaxed);
+		slot.data.store(data, std::memory_order_relaxed);
+	}
+
+	std::unique_ptr<Slot[]> mSlots;
+	std::size_t mMask = 0;
+};
+
+} // namespace chss::search
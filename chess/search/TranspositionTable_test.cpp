@@ -0,0 +1,77 @@
+#include "TranspositionTable.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr bool IsEncodeDecodeCycle(const chss::search::TranspositionTableEntry& entry) {
+	const auto result = detail::DecodeEntry(detail::EncodeEntry(entry));
+	return result.depth == entry.depth && result.score == entry.score && result.bound == entry.bound &&
+		result.move == entry.move;
+}
+
+} // namespace
+
+TEST_CASE("TranspositionTable", "EncodeDecodeEntry") {
+	STATIC_REQUIRE(IsEncodeDecodeCycle(chss::search::TranspositionTableEntry{
+		.depth = 5,
+		.score = -32000,
+		.bound = chss::search::Bound::Upper,
+		.move = std::nullopt}));
+	STATIC_REQUIRE(IsEncodeDecodeCycle(chss::search::TranspositionTableEntry{
+		.depth = 0,
+		.score = 32000,
+		.bound = chss::search::Bound::Lower,
+		.move = chss::Move{.from = chss::positions::H8, .to = chss::positions::A1, .promotionType = std::nullopt}}));
+	STATIC_REQUIRE(IsEncodeDecodeCycle(chss::search::TranspositionTableEntry{
+		.depth = 255,
+		.score = 0,
+		.bound = chss::search::Bound::Exact,
+		.move =
+			chss::Move{.from = chss::positions::B7, .to = chss::positions::A8, .promotionType = chss::PieceType::Knight}}));
+}
+
+TEST(TranspositionTable, ProbeAfterStore) {
+	auto transpositionTable = chss::search::TranspositionTable(1);
+	const auto move = chss::Move{.from = chss::positions::E2, .to = chss::positions::E4, .promotionType = std::nullopt};
+	EXPECT_FALSE(transpositionTable.Probe(1234).has_value());
+	transpositionTable.Store(
+		1234,
+		chss::search::TranspositionTableEntry{.depth = 3, .score = 42, .bound = chss::search::Bound::Exact, .move = move});
+	const auto entryOpt = transpositionTable.Probe(1234);
+	ASSERT_TRUE(entryOpt.has_value());
+	EXPECT_EQ(entryOpt->depth, 3);
+	EXPECT_EQ(entryOpt->score, 42);
+	EXPECT_EQ(entryOpt->bound, chss::search::Bound::Exact);
+	EXPECT_EQ(entryOpt->move, move);
+	EXPECT_FALSE(transpositionTable.Probe(4321).has_value());
+	transpositionTable.Clear();
+	EXPECT_FALSE(transpositionTable.Probe(1234).has_value());
+}
+
+TEST(TranspositionTable, ShallowerBoundDoesNotReplaceDeeperEntry) {
+	auto transpositionTable = chss::search::TranspositionTable(1);
+	const auto move = chss::Move{.from = chss::positions::E2, .to = chss::positions::E4, .promotionType = std::nullopt};
+	transpositionTable.Store(
+		1234,
+		chss::search::TranspositionTableEntry{.depth = 5, .score = 42, .bound = chss::search::Bound::Lower, .move = move});
+	transpositionTable.Store(
+		1234,
+		chss::search::TranspositionTableEntry{
+			.depth = 2,
+			.score = 7,
+			.bound = chss::search::Bound::Upper,
+			.move = std::nullopt});
+	EXPECT_EQ(transpositionTable.Probe(1234)->depth, 5);
+	transpositionTable.Store(
+		1234,
+		chss::search::TranspositionTableEntry{
+			.depth = 6,
+			.score = 7,
+			.bound = chss::search::Bound::Upper,
+			.move = std::nullopt});
+	EXPECT_EQ(transpositionTable.Probe(1234)->depth, 6);
+	EXPECT_EQ(transpositionTable.Probe(1234)->move, move);
+}
@@ -0,0 +1,370 @@
+#pragma once
+
+#include "chess/MinMax.h"
+#include "chess/move_generation/MakeMove.h"
+#include "chess/representation/Move.h"
+#include "chess/representation/State.h"
+#include "chess/search/ThreadData.h"
+
+#include <concurrency/TaskQueue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace chss::search {
+
+// Nodes with less depth than this are searched serially (Search in MinMax.h) by a single thread.
+constexpr int kYbwcMinSplitDepth = 3;
+
+struct YbwcResult {
+	int score;
+	std::int64_t nodes;
+};
+
+/**
+ * What the split searches share: the workers, the data of the serial searches below the split points and the user's
+ * stop flag.
+ *
+ * Every serial search gets a ThreadData from the pool, with no transposition table and no keys of previous positions
+ * (it does not detect repetitions of positions above it), so that its result only depends on its position, depth and
+ * window. The ThreadData must come with empty histories and SearchOptions::updateHistories off, so the histories stay
+ * empty without being cleared for every serial search. There are never more serial searches at the same time than
+ * threads (the workers plus the caller of YbwcIterativeDeepening), so the pool never runs out.
+ */
+class YbwcContext {
+public:
+	YbwcContext(concurrency::TaskQueue* taskQueue, const std::vector<ThreadData*>& threadsData, std::atomic_flag& stop)
+		: mTaskQueue(taskQueue)
+		, mNumWorkers(taskQueue != nullptr ? threadsData.size() - 1 : 0)
+		, mFreeThreadsData(threadsData)
+		, mStop(stop) {}
+
+	[[nodiscard]] std::size_t GetNumWorkers() const {
+		return mNumWorkers;
+	}
+
+	template<typename Task>
+	void PushTask(Task task) {
+		auto lock = std::unique_lock(mMutex);
+		++mPendingTasks;
+		lock.unlock();
+		mTaskQueue->PushBackWithoutFuture([this, task = std::move(task)]() {
+			task();
+			// The notification happens with the mutex locked, so WaitForTasks cannot return, and the context cannot be
+			// destroyed, before it is done.
+			auto lock = std::unique_lock(mMutex);
+			if (--mPendingTasks == 0) {
+				mTasksDone.notify_all();
+			}
+		});
+	}
+
+	// Waits for all the tasks pushed, including the ones that had nothing left to do. It must be called by the owner of
+	// the context once the search is done.
+	void WaitForTasks() {
+		auto lock = std::unique_lock(mMutex);
+		mTasksDone.wait(lock, [this]() { return mPendingTasks == 0; });
+	}
+
+	[[nodiscard]] std::atomic_flag& GetStop() const {
+		return mStop;
+	}
+
+	// For a serial search from the given ply.
+	[[nodiscard]] ThreadData& AcquireThreadData(const CancellationToken& cancellation, const int ply) {
+		auto lock = std::unique_lock(mMutex);
+		assert(!mFreeThreadsData.empty());
+		auto& threadData = *mFreeThreadsData.back();
+		mFreeThreadsData.pop_back();
+		lock.unlock();
+		threadData.transpositionTable = nullptr;
+		threadData.stop = &mStop;
+		threadData.cancellation = &cancellation;
+		threadData.reporter = nullptr;
+		threadData.nodes = 0;
+		assert(!threadData.options.updateHistories);
+		// The search reads its root ply and the two before it, and resets the deeper plies itself before using them.
+		threadData.stack.Reset(std::max(ply - 2, 0), ply);
+		threadData.gameKeys.clear();
+		threadData.rootPly = ply;
+		return threadData;
+	}
+
+	void ReleaseThreadData(ThreadData& threadData) {
+		auto lock = std::unique_lock(mMutex);
+		mFreeThreadsData.push_back(&threadData);
+	}
+
+private:
+	concurrency::TaskQueue* mTaskQueue;
+	std::size_t mNumWorkers;
+	std::mutex mMutex;
+	std::condition_variable mTasksDone;
+	std::vector<ThreadData*> mFreeThreadsData;
+	int mPendingTasks = 0;
+	std::atomic_flag& mStop;
+};
+
+[[nodiscard]] YbwcResult YbwcSearch(
+	const State& state,
+	int depth,
+	int ply,
+	int alpha,
+	int beta,
+	const CancellationToken& cancellation,
+	YbwcContext& context);
+
+} // namespace chss::search
+
+namespace detail {
+
+struct YbwcSibling {
+	std::atomic<bool> isClaimed = false;
+	chss::search::CancellationToken cancellation;
+	int score = 0;
+	std::int64_t nodes = 0;
+};
+
+/**
+ * The young brothers of a node, once the eldest brother has been searched. They all get searched with the same window,
+ * so their results do not depend on which thread searches them or when.
+ *
+ * Each sibling is searched by whoever claims it first: one of the tasks that the split point pushes to the TaskQueue
+ * (one per worker, at most), or the thread that owns the split point. They all claim the siblings that are still
+ * unclaimed, in order, until none is left. So the owner never waits for a task that has not started, and the tasks
+ * that start late have nothing to do (they keep the split point alive while they are queued).
+ */
+struct YbwcSplitPoint {
+	YbwcSplitPoint(
+		const chss::State& state,
+		const chss::search::MoveList& moves,
+		int depth,
+		int ply,
+		int alpha,
+		int beta,
+		const chss::search::CancellationToken& cancellation)
+		: state(state)
+		, moves(moves)
+		, depth(depth)
+		, ply(ply)
+		, alpha(alpha)
+		, beta(beta)
+		, siblings(moves.GetSize())
+		, remaining(static_cast<int>(moves.GetSize()) - 1) {
+		for (auto& sibling : siblings) {
+			sibling.cancellation.parent = &cancellation;
+		}
+	}
+
+	chss::State state;
+	chss::search::MoveList moves;
+	int depth;
+	int ply;
+	int alpha;
+	int beta;
+	std::vector<YbwcSibling> siblings; // Index 0 (the eldest brother) is not used.
+	std::atomic<int> remaining;
+};
+
+inline void SearchYbwcSibling(YbwcSplitPoint& splitPoint, std::size_t index, chss::search::YbwcContext& context) {
+	auto& sibling = splitPoint.siblings[index];
+	if (sibling.isClaimed.exchange(true)) {
+		return;
+	}
+	const auto newState = chss::move_generation::MakeMove(splitPoint.state, splitPoint.moves[index]);
+	const auto result = chss::search::YbwcSearch(
+		newState,
+		splitPoint.depth - 1,
+		splitPoint.ply + 1,
+		-splitPoint.beta,
+		-splitPoint.alpha,
+		sibling.cancellation,
+		context);
+	sibling.score = -result.score;
+	sibling.nodes = result.nodes;
+	if (sibling.score >= splitPoint.beta && !sibling.cancellation.IsCancelled()) {
+		// Beta cutoff: the younger siblings are not needed anymore. The older ones are, to keep the result
+		// deterministic.
+		for (std::size_t i = index + 1; i < splitPoint.siblings.size(); ++i) {
+			splitPoint.siblings[i].cancellation.isCancelled.store(true, std::memory_order_relaxed);
+		}
+	}
+	splitPoint.remaining.fetch_sub(1);
+	splitPoint.remaining.notify_all();
+}
+
+// Claims and searches the siblings that nobody claimed yet.
+inline void SearchUnclaimedYbwcSiblings(YbwcSplitPoint& splitPoint, chss::search::YbwcContext& context) {
+	for (std::size_t i = 1; i < splitPoint.siblings.size(); ++i) {
+		SearchYbwcSibling(splitPoint, i, context);
+	}
+}
+
+// Searches the young brothers in parallel, and returns their scores and nodes through the split point.
+inline void SearchYbwcSiblings(
+	const std::shared_ptr<YbwcSplitPoint>& splitPoint,
+	chss::search::YbwcContext& context) {
+	const auto numTasks = std::min(context.GetNumWorkers(), splitPoint->siblings.size() - 1);
+	for (std::size_t i = 0; i < numTasks; ++i) {
+		context.PushTask([splitPoint, &context]() { SearchUnclaimedYbwcSiblings(*splitPoint, context); });
+	}
+	SearchUnclaimedYbwcSiblings(*splitPoint, context);
+	for (int remaining = splitPoint->remaining.load(); remaining != 0; remaining = splitPoint->remaining.load()) {
+		splitPoint->remaining.wait(remaining);
+	}
+}
+
+} // namespace detail
+
+namespace chss::search {
+
+/**
+ * Young Brothers Wait parallel alpha-beta: the first move of a node is searched before the others, which are then
+ * offered to the idle workers. A beta cutoff cancels the siblings that come after it in move order.
+ *
+ * It is deterministic: the siblings of a split point are searched with the window known after the eldest brother, and
+ * their results are combined in move order, ignoring everything after the first cutoff. So a given position, depth
+ * and window always produce the same score and node count, whatever the number of threads.
+ */
+[[nodiscard]] inline YbwcResult YbwcSearch(
+	const State& state,
+	int depth,
+	int ply,
+	int alpha,
+	int beta,
+	const CancellationToken& cancellation,
+	YbwcContext& context) {
+	if (context.GetStop().test() || cancellation.IsCancelled()) {
+		return YbwcResult{.score = 0, .nodes = 0};
+	}
+	if (depth < kYbwcMinSplitDepth) {
+		auto& threadData = context.AcquireThreadData(cancellation, ply);
+		const auto score = Search(state, depth, ply, alpha, beta, threadData);
+		const auto nodes = threadData.nodes;
+		context.ReleaseThreadData(threadData);
+		return YbwcResult{.score = score, .nodes = nodes};
+	}
+
+	const auto moves = detail::GenerateOrderedMoves(state, std::nullopt);
+	if (moves.IsEmpty()) {
+		return YbwcResult{.score = detail::IsActiveColorInCheck(state) ? MatedIn(ply) : kDraw, .nodes = 1};
+	}
+	const auto eldestState = move_generation::MakeMove(state, moves[0]);
+	const auto eldestResult = YbwcSearch(eldestState, depth - 1, ply + 1, -beta, -alpha, cancellation, context);
+	auto result = YbwcResult{.score = -eldestResult.score, .nodes = 1 + eldestResult.nodes};
+	if (result.score >= beta || moves.GetSize() == 1) {
+		return result;
+	}
+
+	const auto splitPoint = std::make_shared<detail::YbwcSplitPoint>(
+		state,
+		moves,
+		depth,
+		ply,
+		std::max(alpha, result.score),
+		beta,
+		cancellation);
+	detail::SearchYbwcSiblings(splitPoint, context);
+	for (std::size_t i = 1; i < splitPoint->siblings.size(); ++i) {
+		const auto& sibling = splitPoint->siblings[i];
+		result.nodes += sibling.nodes;
+		result.score = std::max(result.score, sibling.score);
+		if (result.score >= beta) {
+			break;
+		}
+	}
+	return result;
+}
+
+/**
+ * The first iteration of YbwcIterativeDeepening, where the score of each move is its evaluation. It is searched
+ * serially, and to the end even if the search gets stopped, so that there is always a move to play.
+ */
+[[nodiscard]] inline std::pair<YbwcResult, Move> YbwcFirstIteration(
+	const State& state,
+	const MoveList& moves,
+	YbwcContext& context) {
+	const auto cancellation = CancellationToken();
+	auto& threadData = context.AcquireThreadData(cancellation, 1);
+	auto noStop = std::atomic_flag(false);
+	threadData.stop = &noStop;
+	auto result = std::pair<YbwcResult, Move>(YbwcResult{.score = -kInfinity, .nodes = 1}, kNoMove);
+	for (const auto& move : moves) {
+		const auto score = -Search(move_generation::MakeMove(state, move), 0, 1, -kInfinity, kInfinity, threadData);
+		if (score > result.first.score) {
+			result.first.score = score;
+			result.second = move;
+		}
+	}
+	result.first.nodes += threadData.nodes;
+	context.ReleaseThreadData(threadData);
+	return result;
+}
+
+/**
+ * Iterative deepening on top of YbwcSearch. From the second iteration on, the root is a split point too; its moves are
+ * ordered by the result of the previous iteration (best move first, the rest in generation order).
+ */
+[[nodiscard]] inline std::pair<YbwcResult, Move> YbwcIterativeDeepening(
+	const State& state,
+	const int maxDepth,
+	YbwcContext& context) {
+	assert(maxDepth > 0);
+	const auto rootCancellation = CancellationToken();
+	auto bestMove = std::optional<Move>();
+	auto result = std::pair<YbwcResult, Move>(YbwcResult{.score = -kInfinity, .nodes = 0}, kNoMove);
+	for (int depth = 1; depth <= maxDepth; ++depth) {
+		const auto moves = detail::GenerateOrderedMoves(state, bestMove);
+		if (moves.IsEmpty()) {
+			break;
+		}
+		if (depth == 1) {
+			result = YbwcFirstIteration(state, moves, context);
+			bestMove = result.second;
+			continue;
+		}
+		const auto splitPoint = std::make_shared<detail::YbwcSplitPoint>(
+			state,
+			moves,
+			depth, // Like the eldest brother, the siblings are searched with splitPoint.depth - 1.
+			0,
+			-kInfinity,
+			kInfinity,
+			rootCancellation);
+		const auto eldestState = move_generation::MakeMove(state, moves[0]);
+		const auto eldestResult =
+			YbwcSearch(eldestState, depth - 1, 1, -kInfinity, kInfinity, rootCancellation, context);
+		if (context.GetStop().test()) {
+			break;
+		}
+		auto iterationResult = std::pair<YbwcResult, Move>(
+			YbwcResult{.score = -eldestResult.score, .nodes = result.first.nodes + 1 + eldestResult.nodes},
+			moves[0]);
+		splitPoint->alpha = iterationResult.first.score;
+		detail::SearchYbwcSiblings(splitPoint, context);
+		if (context.GetStop().test()) {
+			break;
+		}
+		for (std::size_t i = 1; i < splitPoint->siblings.size(); ++i) {
+			const auto& sibling = splitPoint->siblings[i];
+			iterationResult.first.nodes += sibling.nodes;
+			if (sibling.score > iterationResult.first.score) {
+				iterationResult.first.score = sibling.score;
+				iterationResult.second = moves[i];
+			}
+		}
+		result = iterationResult;
+		bestMove = result.second;
+	}
+	return result;
+}
+
+} // namespace chss::search
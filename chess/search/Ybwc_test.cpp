@@ -0,0 +1,89 @@
+#include "Ybwc.h"
+
+#include "chess/fen/Fen.h"
+#include "chess/search/Searcher.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+constexpr auto kStartPosition = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+constexpr auto kKiwipete = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+constexpr auto kEndgame = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+// Quiet moves only: the leaves of the serial searches two plies below the root must not be mistaken for repetitions.
+constexpr auto kRookEnding = "4k3/8/8/8/8/8/8/R3K3 w - - 0 1";
+
+} // namespace
+
+TEST(Ybwc, MateInTwo) {
+	auto searcher = chss::search::Searcher(2);
+	searcher.SetParallelMode(chss::search::ParallelMode::YBWC);
+	auto stop = std::atomic_flag(false);
+	const auto [score, move] = searcher.Search(chss::fen::Parse("7K/8/8/8/6R1/7R/1k6/8 w - - 0 1"), 4, stop);
+	EXPECT_EQ(score, chss::search::MateIn(3));
+	EXPECT_TRUE(stop.test());
+}
+
+TEST(Ybwc, ScoreMatchesSerialAlphaBeta) {
+	// YBWC only prunes through alpha-beta above its serial searches, so the serial search must not prune either.
+	const auto options = chss::search::SearchOptions{
+		.useAspirationWindows = false,
+		.useNullMovePruning = false,
+		.useLateMoveReductions = false,
+		.useFrontierPruning = false,
+		.useExtensions = false,
+		.useProbCut = false,
+		.internalIteration = chss::search::InternalIteration::None};
+	auto searcher = chss::search::Searcher(3);
+	searcher.SetParallelMode(chss::search::ParallelMode::YBWC);
+	searcher.SetOptions(options);
+	for (const auto fen : {kStartPosition, kKiwipete, kEndgame, kRookEnding}) {
+		const auto state = chss::fen::Parse(fen);
+		for (int depth = 1; depth <= 5; ++depth) {
+			auto stop = std::atomic_flag(false);
+			auto threadData = chss::search::ThreadData{
+				.id = 0,
+				.transpositionTable = nullptr,
+				.stop = &stop,
+				.nodes = 0,
+				.options = options};
+			const auto [serialScore, serialMove] = chss::search::SearchRoot(state, depth, threadData);
+			const auto [score, move] = searcher.Search(state, depth, stop);
+			EXPECT_EQ(score, serialScore) << fen << " at depth " << depth;
+		}
+	}
+}
+
+TEST(Ybwc, SameNodesWhateverTheNumberOfThreads) {
+	const auto state = chss::fen::Parse(kKiwipete);
+	auto expectedSearcher = chss::search::Searcher(1);
+	expectedSearcher.SetParallelMode(chss::search::ParallelMode::YBWC);
+	auto expectedStop = std::atomic_flag(false);
+	const auto expected = expectedSearcher.Search(state, 3, expectedStop);
+	const auto expectedNodes = expectedSearcher.GetNodes();
+	EXPECT_GT(expectedNodes, 0);
+
+	for (const auto numThreads : {1, 2, 4}) {
+		auto searcher = chss::search::Searcher(numThreads);
+		searcher.SetParallelMode(chss::search::ParallelMode::YBWC);
+		for (int i = 0; i < 2; ++i) {
+			auto stop = std::atomic_flag(false);
+			const auto result = searcher.Search(state, 3, stop);
+			EXPECT_EQ(result, expected) << numThreads << " threads";
+			EXPECT_EQ(searcher.GetNodes(), expectedNodes) << numThreads << " threads";
+		}
+	}
+}
+
+TEST(Ybwc, StoppedSearchCompletesTheFirstIteration) {
+	const auto state = chss::fen::Parse(kKiwipete);
+	auto searcher = chss::search::Searcher(2);
+	searcher.SetParallelMode(chss::search::ParallelMode::YBWC);
+	auto stop = std::atomic_flag(false);
+	const auto expected = searcher.Search(state, 1, stop);
+
+	auto stopped = std::atomic_flag(true);
+	const auto result = searcher.Search(state, 5, stopped);
+	EXPECT_NE(result.second, chss::search::kNoMove);
+	EXPECT_EQ(result, expected);
+}
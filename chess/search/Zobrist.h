@@ -0,0 +1,86 @@
+#pragma once
+
+#include "chess/representation/State.h"
+
+#include <array>
+#include <cstdint>
+
+namespace detail {
+
+// xorshift64* pseudo random number generator, so the keys can be generated at compile time.
+[[nodiscard]] constexpr std::uint64_t NextRandom(std::uint64_t& seed) {
+	seed ^= seed >> 12;
+	seed ^= seed << 25;
+	seed ^= seed >> 27;
+	return seed * 2685821657736338717ULL;
+}
+
+struct ZobristKeys {
+	std::array<std::uint64_t, 2 * 6 * 64> pieces;
+	std::uint64_t blackToMove;
+	// One key per combination of castling rights (indexed by the CastlingRights mask), the key of no rights being 0.
+	std::array<std::uint64_t, 16> castling;
+	std::array<std::uint64_t, 8> enPassantFile;
+};
+
+[[nodiscard]] constexpr ZobristKeys CreateZobristKeys() {
+	auto keys = ZobristKeys();
+	std::uint64_t seed = 1070372ULL;
+	for (auto& key : keys.pieces) {
+		key = NextRandom(seed);
+	}
+	keys.blackToMove = NextRandom(seed);
+	auto castlingRightKeys = std::array<std::uint64_t, 4>();
+	for (auto& key : castlingRightKeys) {
+		key = NextRandom(seed);
+	}
+	for (std::size_t rights = 0; rights < keys.castling.size(); ++rights) {
+		keys.castling[rights] = 0;
+		for (std::size_t i = 0; i < castlingRightKeys.size(); ++i) {
+			if ((rights >> i) & 1) {
+				keys.castling[rights] ^= castlingRightKeys[i];
+			}
+		}
+	}
+	for (auto& key : keys.enPassantFile) {
+		key = NextRandom(seed);
+	}
+	return keys;
+}
+
+constexpr auto kZobristKeys = CreateZobristKeys();
+
+[[nodiscard]] constexpr std::size_t ZobristPieceIndex(const chss::Piece& piece, const chss::Position& position) {
+	const auto colorIndex = static_cast<std::size_t>(piece.color);
+	const auto typeIndex = static_cast<std::size_t>(piece.type);
+	const auto squareIndex = static_cast<std::size_t>(position.y * 8 + position.x);
+	return (colorIndex * 6 + typeIndex) * 64 + squareIndex;
+}
+
+} // namespace detail
+
+namespace chss::search::zobrist {
+
+/**
+ * Zobrist hash of the position: pieces, side to move, castling rights and en passant file.
+ * The halfmove clock and the fullmove number are not part of the key, so transpositions get the same key.
+ */
+[[nodiscard]] constexpr std::uint64_t Hash(const State& state) {
+	std::uint64_t key = 0;
+	for (const auto position : ForEach(state.board.GetSize())) {
+		const auto& pieceOpt = state.board.At(position);
+		if (pieceOpt.has_value()) {
+			key ^= detail::kZobristKeys.pieces[detail::ZobristPieceIndex(pieceOpt.value(), position)];
+		}
+	}
+	if (state.activeColor == Color::Black) {
+		key ^= detail::kZobristKeys.blackToMove;
+	}
+	key ^= detail::kZobristKeys.castling[static_cast<std::size_t>(state.castlingRights)];
+	if (state.enPassantTargetSquare.has_value()) {
+		key ^= detail::kZobristKeys.enPassantFile[state.enPassantTargetSquare.value().x];
+	}
+	return key;
+}
+
+} // namespace chss::search::zobrist
@@ -0,0 +1,45 @@
+#include "Zobrist.h"
+
+#include "chess/fen/Fen.h"
+#include "chess/move_generation/MakeMove.h"
+
+#include <test_utils/TestUtils.h>
+
+namespace {
+
+constexpr chss::State MakeMoves(chss::State state, const std::initializer_list<chss::Move> moves) {
+	for (const auto& move : moves) {
+		state = chss::move_generation::MakeMove(state, move);
+	}
+	return state;
+}
+
+} // namespace
+
+TEST_CASE("Zobrist", "DifferentPositionsHaveDifferentKeys") {
+	constexpr auto state = chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	STATIC_REQUIRE(
+		chss::search::zobrist::Hash(state) !=
+		chss::search::zobrist::Hash(chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1")));
+	STATIC_REQUIRE(
+		chss::search::zobrist::Hash(state) !=
+		chss::search::zobrist::Hash(chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w Kkq - 0 1")));
+	STATIC_REQUIRE(
+		chss::search::zobrist::Hash(state) !=
+		chss::search::zobrist::Hash(chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKB1R w KQkq - 0 1")));
+	STATIC_REQUIRE(
+		chss::search::zobrist::Hash(chss::fen::Parse("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1")) !=
+		chss::search::zobrist::Hash(chss::fen::Parse("4k3/8/8/3pP3/8/8/8/4K3 w - - 0 1")));
+}
+
+TEST_CASE("Zobrist", "TranspositionsHaveTheSameKey") {
+	constexpr auto state = chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+	constexpr auto newState = MakeMoves(
+		state,
+		{chss::Move{.from = chss::positions::G1, .to = chss::positions::F3, .promotionType = std::nullopt},
+		 chss::Move{.from = chss::positions::G8, .to = chss::positions::F6, .promotionType = std::nullopt},
+		 chss::Move{.from = chss::positions::F3, .to = chss::positions::G1, .promotionType = std::nullopt},
+		 chss::Move{.from = chss::positions::F6, .to = chss::positions::G8, .promotionType = std::nullopt}});
+	STATIC_REQUIRE(!(newState == state));
+	STATIC_REQUIRE(chss::search::zobrist::Hash(newState) == chss::search::zobrist::Hash(state));
+}
@@ -7,13 +7,20 @@
 #include "chess/Perft.h"
 #include "chess/representation/Move.h"
 #include "chess/representation/State.h"
+#include "chess/search/Searcher.h"
+#include "chess/search/TimeManagement.h"
+#include "chess/search/Zobrist.h"
 
 #include <concurrency/TaskQueue.h>
 #include <concurrency/ThreadSafeQueue.h>
 #include <cpp_utils/Overloaded.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -40,7 +47,7 @@ std::string PromotionToString(const std::optional<chss::PieceType>& promotionTyp
 chss::Position ParsePosition(const std::string_view& input) {
 	const auto x = input[0] - 'a';
 	const auto y = input[1] - '1';
-	return chss::Position{.x = x, .y = y};
+	return chss::Position{.y = y, .x = x};
 }
 
 std::optional<chss::PieceType> ParsePromotion(const std::string_view& input) {
@@ -71,6 +78,115 @@ chss::Move ParseMove(const std::string_view& input) {
 	return chss::Move{.from = from, .to = to, .promotionType = promotionType};
 }
 
+// Plays the moves tokens[firstMoveIndex...] on the state. Returns the Zobrist keys of the positions before the final one,
+// oldest first, since the last irreversible move (the earlier ones cannot be repeated).
+std::vector<std::uint64_t> PlayMoves(
+	chss::State& state,
+	const std::vector<std::string>& tokens,
+	const std::size_t firstMoveIndex) {
+	auto gameKeys = std::vector<std::uint64_t>();
+	for (std::size_t i = firstMoveIndex; i < tokens.size(); ++i) {
+		gameKeys.push_back(chss::search::zobrist::Hash(state));
+		state = chss::move_generation::MakeMove(state, ParseMove(tokens[i]));
+		if (state.halfmoveClock == 0) {
+			gameKeys.clear();
+		}
+	}
+	return gameKeys;
+}
+
+std::string MoveToString(const chss::Move& move) {
+	const auto fromStr = std::string(chss::debug::PositionToString(move.from));
+	const auto toStr = std::string(chss::debug::PositionToString(move.to));
+	return fromStr + toStr + PromotionToString(move.promotionType);
+}
+
+std::string ScoreToString(const int score) {
+	if (chss::search::IsMateScore(score)) {
+		return "mate " + std::to_string(chss::search::MateInMoves(score));
+	}
+	return "cp " + std::to_string(score);
+}
+
+/**
+ * Turns the progress of the search into "info" lines, which the UCI loop prints as they come. The lines with a bound
+ * (aspiration window fails) and the current root move are only reported after kDetailedReportDelay, and the node
+ * counts at most once every kProgressReportPeriod, not to flood the GUI in short searches.
+ */
+class UciReporter final : public chss::search::SearchReporter {
+public:
+	static constexpr auto kDetailedReportDelay = std::chrono::milliseconds(3000);
+	static constexpr auto kProgressReportPeriod = std::chrono::milliseconds(1000);
+
+	UciReporter(const chss::State& state, const chss::search::Searcher& searcher)
+		: mState(state)
+		, mSearcher(searcher)
+		, mStart(std::chrono::steady_clock::now())
+		, mLastProgress(mStart) {}
+
+	void ReportIteration(const chss::search::IterationReport& report) override {
+		if (report.bound != chss::search::Bound::Exact && GetElapsedTime() < kDetailedReportDelay) {
+			return;
+		}
+		auto ss = std::stringstream();
+		ss << "info depth " << report.depth << " seldepth " << report.selDepth << " multipv " << report.multiPv
+		   << " score " << ScoreToString(report.score);
+		if (report.bound == chss::search::Bound::Lower) {
+			ss << " lowerbound";
+		} else if (report.bound == chss::search::Bound::Upper) {
+			ss << " upperbound";
+		}
+		ss << " " << GetProgress() << " pv";
+		for (const auto& move : mSearcher.GetPrincipalVariation(mState, report.principalVariation)) {
+			ss << " " << MoveToString(move);
+		}
+		mLines.Push(ss.str());
+	}
+
+	void ReportCurrentMove(const chss::search::CurrentMoveReport& report) override {
+		if (GetElapsedTime() < kDetailedReportDelay) {
+			return;
+		}
+		mLines.Push(
+			"info depth " + std::to_string(report.depth) + " currmove " + MoveToString(report.move) +
+			" currmovenumber " + std::to_string(report.moveNumber));
+	}
+
+	void ReportProgress() override {
+		const auto now = std::chrono::steady_clock::now();
+		if (now - mLastProgress < kProgressReportPeriod) {
+			return;
+		}
+		mLastProgress = now;
+		mLines.Push("info " + GetProgress());
+	}
+
+	// The next line to print, if any. It is called from the UCI loop while the search thread reports.
+	[[nodiscard]] std::optional<std::string> TryPopLine() {
+		return mLines.TryPop();
+	}
+
+private:
+	[[nodiscard]] std::chrono::milliseconds GetElapsedTime() const {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - mStart);
+	}
+
+	// "nodes N nps N hashfull N time N". The nodes of all the threads are only summed here.
+	[[nodiscard]] std::string GetProgress() const {
+		const auto nodes = mSearcher.GetNodes();
+		const auto time = GetElapsedTime().count();
+		const auto nodesPerSecond = nodes * 1000 / std::max<std::int64_t>(time, 1);
+		return "nodes " + std::to_string(nodes) + " nps " + std::to_string(nodesPerSecond) + " hashfull " +
+			std::to_string(mSearcher.GetHashFull()) + " time " + std::to_string(time);
+	}
+
+	const chss::State mState;
+	const chss::search::Searcher& mSearcher;
+	const std::chrono::steady_clock::time_point mStart;
+	std::chrono::steady_clock::time_point mLastProgress;
+	concurrency::ThreadSafeQueue<std::string> mLines;
+};
+
 struct Ready {
 	chss::State state;
 };
@@ -79,6 +195,16 @@ struct BestMoveCalculation {
 	chss::State state;
 	std::atomic_flag stopFlag;
 	std::future<std::pair<int, chss::Move>> bestMove;
+	std::unique_ptr<UciReporter> reporter;
+	// Result of the search once it finishes. While pondering or searching infinitely, it waits for "ponderhit" or
+	// "stop" to be sent.
+	std::optional<std::pair<int, chss::Move>> result;
+	bool isPondering = false;
+	bool isInfinite = false;
+	// Time to spend on the move, if the search has a time limit. It starts counting at "go", or at "ponderhit" when
+	// pondering.
+	std::optional<std::chrono::milliseconds> allocatedTime;
+	std::optional<std::chrono::steady_clock::time_point> deadline;
 };
 
 struct PerftCalculation {
@@ -93,7 +219,21 @@ void UciCommand(const std::vector<std::string>& tokens, std::ostream& out, UciSt
 	std::visit(
 		Overloaded(
 			[&out, &uciState](Ready& ready) {
-				out << "id name chss\nid author ifrison\nuciok\n" << std::flush;
+				out << "id name chss\nid author ifrison\n";
+				out << "option name Threads type spin default 1 min 1 max " << chss::search::Searcher::kMaxThreads << "\n";
+				out << "option name Hash type spin default " << chss::search::Searcher::kDefaultHashSizeInMegaBytes
+					<< " min 1 max 65536\n";
+				out << "option name Ponder type check default false\n";
+				out << "option name MultiPV type spin default 1 min 1 max " << chss::search::kMaxMoves << "\n";
+				out << "option name NullMovePruning type check default true\n";
+				out << "option name LateMoveReductions type check default true\n";
+				out << "option name FrontierPruning type check default true\n";
+				out << "option name Extensions type check default true\n";
+				out << "option name ProbCut type check default true\n";
+				out << "option name ParallelMode type combo default LazySMP var LazySMP var YBWC\n";
+				out << "option name InternalIteration type combo default Reductions var None var Reductions"
+					<< " var Deepening\n";
+				out << "uciok\n" << std::flush;
 			},
 			[&out, &uciState](BestMoveCalculation& bestMoveCalculation) {
 				out << "\"uci\" command is not supported while calculating BestMove.\n" << std::flush;
@@ -104,31 +244,25 @@ void UciCommand(const std::vector<std::string>& tokens, std::ostream& out, UciSt
 		uciState);
 }
 
-void PositionCommand(const std::vector<std::string>& tokens, std::ostream& out, UciState& uciState) {
+void PositionCommand(
+	const std::vector<std::string>& tokens,
+	std::ostream& out,
+	UciState& uciState,
+	chss::search::Searcher& searcher) {
 	std::visit(
 		Overloaded(
-			[&tokens, &out, &uciState](Ready& ready) {
+			[&tokens, &out, &uciState, &searcher](Ready& ready) {
 				if (tokens[1] == "startpos") {
 					auto newState = chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
-					if (tokens.size() > 2) {
-						assert(tokens[2] == "moves");
-						for (size_t i = 3; i < tokens.size(); ++i) {
-							const auto move = ParseMove(tokens[i]);
-							newState = chss::move_generation::MakeMove(newState, move);
-						}
-					}
+					assert(tokens.size() == 2 || tokens[2] == "moves");
+					searcher.SetGameKeys(PlayMoves(newState, tokens, 3));
 					ready.state = newState;
 				} else if (tokens[1] == "fen") {
 					assert(tokens.size() >= 8);
 					const auto fenString = tokens[2] + " " + tokens[3] + " " + tokens[4] + " " + tokens[5] + " " + tokens[6] + " " + tokens[7];
 					auto newState = chss::fen::Parse(fenString);
-					if (tokens.size() > 8) {
-						assert(tokens[8] == "moves");
-						for (size_t i = 9; i < tokens.size(); ++i) {
-							const auto move = ParseMove(tokens[i]);
-							newState = chss::move_generation::MakeMove(newState, move);
-						}
-					}
+					assert(tokens.size() == 8 || tokens[8] == "moves");
+					searcher.SetGameKeys(PlayMoves(newState, tokens, 9));
 					ready.state = newState;
 				} else {
 					out << "\"position " << tokens[1] << "\" command is not known.\n" << std::flush;
@@ -158,20 +292,148 @@ void IsReadyCommand(const std::vector<std::string>& tokens, std::ostream& out, U
 		uciState);
 }
 
-void GoCommand(const std::vector<std::string>& tokens, std::ostream& out, UciState& uciState) {
+void SetOptionCommand(
+	const std::vector<std::string>& tokens,
+	std::ostream& out,
+	UciState& uciState,
+	chss::search::Searcher& searcher) {
+	std::visit(
+		Overloaded(
+			[&tokens, &out, &searcher](Ready&) {
+				if (tokens.size() < 5 || tokens[1] != "name" || tokens[3] != "value") {
+					out << "\"setoption\" command is malformed.\n" << std::flush;
+				} else if (tokens[2] == "Threads") {
+					const auto numThreads = std::stoi(tokens[4]);
+					searcher.SetNumThreads(std::clamp(numThreads, 1, chss::search::Searcher::kMaxThreads));
+				} else if (tokens[2] == "Hash") {
+					const auto sizeInMegaBytes = std::stoi(tokens[4]);
+					searcher.SetHashSize(static_cast<std::size_t>(std::clamp(sizeInMegaBytes, 1, 65536)));
+				} else if (tokens[2] == "Ponder" && (tokens[4] == "true" || tokens[4] == "false")) {
+					// Nothing to set up: the GUI decides when to ponder with "go ponder".
+				} else if (tokens[2] == "MultiPV") {
+					auto options = searcher.GetOptions();
+					options.multiPv = std::clamp(std::stoi(tokens[4]), 1, static_cast<int>(chss::search::kMaxMoves));
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "NullMovePruning" && (tokens[4] == "true" || tokens[4] == "false")) {
+					auto options = searcher.GetOptions();
+					options.useNullMovePruning = tokens[4] == "true";
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "LateMoveReductions" && (tokens[4] == "true" || tokens[4] == "false")) {
+					auto options = searcher.GetOptions();
+					options.useLateMoveReductions = tokens[4] == "true";
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "FrontierPruning" && (tokens[4] == "true" || tokens[4] == "false")) {
+					auto options = searcher.GetOptions();
+					options.useFrontierPruning = tokens[4] == "true";
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "Extensions" && (tokens[4] == "true" || tokens[4] == "false")) {
+					auto options = searcher.GetOptions();
+					options.useExtensions = tokens[4] == "true";
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "ProbCut" && (tokens[4] == "true" || tokens[4] == "false")) {
+					auto options = searcher.GetOptions();
+					options.useProbCut = tokens[4] == "true";
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "ParallelMode" && tokens[4] == "LazySMP") {
+					searcher.SetParallelMode(chss::search::ParallelMode::LazySMP);
+				} else if (tokens[2] == "ParallelMode" && tokens[4] == "YBWC") {
+					searcher.SetParallelMode(chss::search::ParallelMode::YBWC);
+				} else if (tokens[2] == "InternalIteration" && tokens[4] == "None") {
+					auto options = searcher.GetOptions();
+					options.internalIteration = chss::search::InternalIteration::None;
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "InternalIteration" && tokens[4] == "Reductions") {
+					auto options = searcher.GetOptions();
+					options.internalIteration = chss::search::InternalIteration::Reductions;
+					searcher.SetOptions(options);
+				} else if (tokens[2] == "InternalIteration" && tokens[4] == "Deepening") {
+					auto options = searcher.GetOptions();
+					options.internalIteration = chss::search::InternalIteration::Deepening;
+					searcher.SetOptions(options);
+				} else {
+					out << "\"setoption name " << tokens[2] << "\" option is not known.\n" << std::flush;
+				}
+			},
+			[&out](BestMoveCalculation&) {
+				out << "\"setoption\" command is not supported while calculating BestMove.\n" << std::flush;
+			},
+			[&out](PerftCalculation&) {
+				out << "\"setoption\" command is not supported while calculating Perft.\n" << std::flush;
+			}),
+		uciState);
+}
+
+// Parses "go [ponder] [wtime X] [btime X] [winc X] [binc X] [movestogo X] [movetime X] [depth X] [infinite]".
+std::optional<chss::search::SearchLimits> ParseSearchLimits(const std::vector<std::string>& tokens, std::ostream& out) {
+	auto limits = chss::search::SearchLimits();
+	const auto white = static_cast<std::size_t>(chss::Color::White);
+	const auto black = static_cast<std::size_t>(chss::Color::Black);
+	for (std::size_t i = 1; i < tokens.size(); ++i) {
+		const auto& token = tokens[i];
+		if (token == "ponder") {
+			limits.ponder = true;
+		} else if (token == "infinite") {
+			limits.infinite = true;
+		} else if (i + 1 == tokens.size()) {
+			out << "\"go " << token << "\" command is not known.\n" << std::flush;
+			return std::nullopt;
+		} else if (token == "depth") {
+			limits.depth = std::stoi(tokens[++i]);
+		} else if (token == "movestogo") {
+			limits.movesToGo = std::stoi(tokens[++i]);
+		} else if (token == "movetime") {
+			limits.moveTime = std::chrono::milliseconds(std::stoll(tokens[++i]));
+		} else if (token == "wtime") {
+			limits.time[white] = std::chrono::milliseconds(std::stoll(tokens[++i]));
+		} else if (token == "btime") {
+			limits.time[black] = std::chrono::milliseconds(std::stoll(tokens[++i]));
+		} else if (token == "winc") {
+			limits.increment[white] = std::chrono::milliseconds(std::stoll(tokens[++i]));
+		} else if (token == "binc") {
+			limits.increment[black] = std::chrono::milliseconds(std::stoll(tokens[++i]));
+		} else {
+			out << "\"go " << token << "\" command is not known.\n" << std::flush;
+			return std::nullopt;
+		}
+	}
+	return limits;
+}
+
+void GoCommand(
+	const std::vector<std::string>& tokens,
+	std::ostream& out,
+	UciState& uciState,
+	chss::search::Searcher& searcher) {
 	return std::visit(
 		Overloaded(
-			[&tokens, &out, &uciState](Ready& ready) {
-				if (tokens[1] == "depth") {
-					const auto depth = std::stoi(tokens[2]);
+			[&tokens, &out, &uciState, &searcher](Ready& ready) {
+				if (tokens.size() == 1 || tokens[1] != "perft") {
+					const auto limitsOpt = ParseSearchLimits(tokens, out);
+					if (!limitsOpt.has_value()) {
+						return;
+					}
+					const auto& limits = limitsOpt.value();
+					constexpr auto kMaxDepth = chss::search::kMaxPly - 1;
+					const auto depth = std::clamp(limits.depth.value_or(kMaxDepth), 1, kMaxDepth);
 					auto stateTmp = std::move(ready).state;
 					auto& bestMoveCalculation = uciState.emplace<BestMoveCalculation>();
 					bestMoveCalculation.state = std::move(stateTmp);
+					bestMoveCalculation.isPondering = limits.ponder;
+					bestMoveCalculation.isInfinite = limits.infinite;
+					bestMoveCalculation.allocatedTime =
+						chss::search::AllocateTime(limits, bestMoveCalculation.state.activeColor);
+					if (bestMoveCalculation.allocatedTime.has_value() && !limits.ponder) {
+						bestMoveCalculation.deadline =
+							std::chrono::steady_clock::now() + bestMoveCalculation.allocatedTime.value();
+					}
 					bestMoveCalculation.stopFlag.clear();
-					bestMoveCalculation.bestMove =
-						std::async([state = bestMoveCalculation.state, &stopFlag = bestMoveCalculation.stopFlag, depth]() {
-							return chss::search::ParallelSearchMove(state, depth, stopFlag);
-						});
+					bestMoveCalculation.reporter = std::make_unique<UciReporter>(bestMoveCalculation.state, searcher);
+					bestMoveCalculation.bestMove = std::async(
+						[state = bestMoveCalculation.state,
+						 &stopFlag = bestMoveCalculation.stopFlag,
+						 reporter = bestMoveCalculation.reporter.get(),
+						 depth,
+						 &searcher]() { return searcher.Search(state, depth, stopFlag, reporter); });
 				} else if (tokens[1] == "perft") {
 					const auto depth = std::stoi(tokens[2]);
 					auto stateTmp = std::move(ready).state;
@@ -182,8 +444,6 @@ void GoCommand(const std::vector<std::string>& tokens, std::ostream& out, UciSta
 						std::async([state = perftCalculation.state, &stopFlag = perftCalculation.stopFlag, depth]() {
 							return chss::move_generation::ParallelPerft(state, depth, stopFlag);
 						});
-				} else {
-					out << "\"go " << tokens[1] << "\" command is not known.\n" << std::flush;
 				}
 			},
 			[&out, &uciState](BestMoveCalculation& bestMoveCalculation) {
@@ -195,19 +455,90 @@ void GoCommand(const std::vector<std::string>& tokens, std::ostream& out, UciSta
 		uciState);
 }
 
-void StopCommand(const std::vector<std::string>& tokens, std::ostream& out, UciState& uciState) {
+void PrintReportedLines(std::ostream& out, BestMoveCalculation& bestMoveCalculation) {
+	auto isAnyLine = false;
+	while (auto line = bestMoveCalculation.reporter->TryPopLine()) {
+		out << line.value() << "\n";
+		isAnyLine = true;
+	}
+	if (isAnyLine) {
+		out << std::flush;
+	}
+}
+
+// Counters of the last search, as an "info string" line.
+void PrintSearchStats(std::ostream& out, const chss::search::Searcher& searcher) {
+	const auto stats = searcher.GetStats();
+	out << "info string qnodes " << stats.quiescenceNodes << " aspirationfailhighs " << stats.aspirationFailHighs
+		<< " aspirationfaillows " << stats.aspirationFailLows << " pvsresearches " << stats.pvsReSearches
+		<< " nullmovecutoffs " << stats.nullMoveCutoffs << "/" << stats.nullMoveTries << " lmrresearches "
+		<< stats.lateMoveReSearches << "/" << stats.lateMoveReductions << " reversefutility "
+		<< stats.reverseFutilityPrunes << " razoring " << stats.razoringPrunes << " futility " << stats.futilityPrunes
+		<< " latemovepruning " << stats.lateMovePrunes << " checkextensions " << stats.checkExtensions
+		<< " singularextensions " << stats.singularExtensions << "/" << stats.singularSearches << " probcut "
+		<< stats.probCutCutoffs << "/" << stats.probCutTries << " iir " << stats.internalIterativeReductions << " iid "
+		<< stats.internalIterativeDeepenings << "\n";
+}
+
+// The lines of the search, best first ("info multipv K score cp X|mate N nodes N pv ..."), and the best move ("0000" if
+// there is no legal move) with the expected reply to ponder on.
+void PrintBestMove(
+	std::ostream& out,
+	const chss::search::Searcher& searcher,
+	const chss::State& state,
+	const int score,
+	const chss::Move& move) {
+	if (move == chss::search::kNoMove) {
+		out << "info score " << ScoreToString(score) << " nodes " << searcher.GetNodes() << "\n";
+		PrintSearchStats(out, searcher);
+		out << "bestmove 0000" << std::endl;
+		return;
+	}
+	auto lines = searcher.GetRootLines();
+	if (lines.empty() || lines.front().move != move) {
+		auto line = chss::search::RootLine{.score = score, .move = move};
+		line.principalVariation.PushBack(move);
+		lines = {line};
+	}
+	auto principalVariation = std::vector<chss::Move>();
+	for (std::size_t i = 0; i < lines.size(); ++i) {
+		const auto linePrincipalVariation = searcher.GetPrincipalVariation(state, lines[i].principalVariation);
+		out << "info multipv " << i + 1 << " score " << ScoreToString(lines[i].score) << " nodes "
+			<< searcher.GetNodes() << " pv";
+		for (const auto& pvMove : linePrincipalVariation) {
+			out << " " << MoveToString(pvMove);
+		}
+		out << "\n";
+		if (i == 0) {
+			principalVariation = linePrincipalVariation;
+		}
+	}
+	PrintSearchStats(out, searcher);
+	out << "bestmove " << MoveToString(move);
+	if (principalVariation.size() >= 2) {
+		out << " ponder " << MoveToString(principalVariation[1]);
+	}
+	out << std::endl;
+}
+
+void StopCommand(
+	const std::vector<std::string>& tokens,
+	std::ostream& out,
+	UciState& uciState,
+	const chss::search::Searcher& searcher) {
 	std::visit(
 		Overloaded(
 			[&tokens, &out, &uciState](Ready& ready) {
 				out << "\"stop\" command is not supported while Ready.\n" << std::flush;
 			},
-			[&out, &uciState](BestMoveCalculation& bestMoveCalculation) {
+			[&out, &uciState, &searcher](BestMoveCalculation& bestMoveCalculation) {
 				bestMoveCalculation.stopFlag.test_and_set();
-				const auto [score, move] = bestMoveCalculation.bestMove.get();
-				const auto fromStr = std::string(chss::debug::PositionToString(move.from));
-				const auto toStr = std::string(chss::debug::PositionToString(move.to));
-				const auto promotionStr = PromotionToString(move.promotionType);
-				out << "bestmove " << fromStr << toStr << promotionStr << std::endl;
+				if (!bestMoveCalculation.result.has_value()) {
+					bestMoveCalculation.result = bestMoveCalculation.bestMove.get();
+				}
+				PrintReportedLines(out, bestMoveCalculation);
+				const auto [score, move] = bestMoveCalculation.result.value();
+				PrintBestMove(out, searcher, bestMoveCalculation.state, score, move);
 				auto stateTmp = std::move(bestMoveCalculation).state;
 				uciState = Ready{.state = std::move(stateTmp)};
 			},
@@ -221,6 +552,70 @@ void StopCommand(const std::vector<std::string>& tokens, std::ostream& out, UciS
 		uciState);
 }
 
+// The opponent played the expected move: the ponder search goes on as the real one, under the time limits of the "go
+// ponder" command, counted from now. Its transposition table and histories are kept.
+void PonderHitCommand(const std::vector<std::string>&, std::ostream& out, UciState& uciState) {
+	std::visit(
+		Overloaded(
+			[&out](Ready&) {
+				out << "\"ponderhit\" command is not supported while Ready.\n" << std::flush;
+			},
+			[&out](BestMoveCalculation& bestMoveCalculation) {
+				if (!bestMoveCalculation.isPondering) {
+					out << "\"ponderhit\" command is not supported while not pondering.\n" << std::flush;
+					return;
+				}
+				bestMoveCalculation.isPondering = false;
+				if (bestMoveCalculation.allocatedTime.has_value()) {
+					bestMoveCalculation.deadline =
+						std::chrono::steady_clock::now() + bestMoveCalculation.allocatedTime.value();
+				}
+			},
+			[&out](PerftCalculation&) {
+				out << "\"ponderhit\" command is not supported while calculating Perft.\n" << std::flush;
+			}),
+		uciState);
+}
+
+// Clears what the searcher learned from the previous game.
+void UciNewGameCommand(
+	const std::vector<std::string>&,
+	std::ostream& out,
+	UciState& uciState,
+	chss::search::Searcher& searcher) {
+	std::visit(
+		Overloaded(
+			[&searcher](Ready&) {
+				searcher.Clear();
+				searcher.SetGameKeys({});
+			},
+			[&out](BestMoveCalculation&) {
+				out << "\"ucinewgame\" command is not supported while calculating BestMove.\n" << std::flush;
+			},
+			[&out](PerftCalculation&) {
+				out << "\"ucinewgame\" command is not supported while calculating Perft.\n" << std::flush;
+			}),
+		uciState);
+}
+
+// Stops any calculation without printing its result.
+void QuitCommand(UciState& uciState) {
+	std::visit(
+		Overloaded(
+			[](Ready&) {
+				// Do nothing.
+			},
+			[](BestMoveCalculation& bestMoveCalculation) {
+				bestMoveCalculation.stopFlag.test_and_set();
+				bestMoveCalculation.bestMove.wait();
+			},
+			[](PerftCalculation& perftCalculation) {
+				perftCalculation.stopFlag.test_and_set();
+				perftCalculation.nodesVisited.wait();
+			}),
+		uciState);
+}
+
 } // namespace
 
 namespace chss::uci {
@@ -230,12 +625,18 @@ void UCI(std::istream& in, std::ostream& out) {
 	auto inputThread = std::thread([&in, &inputQueue]() {
 		auto line = std::string();
 		while (std::getline(in, line)) {
-			if (!line.empty()) {
+			const auto tokens = SplitInTokens(line);
+			if (!tokens.empty()) {
 				inputQueue.Push(std::move(line));
 			}
+			// Nothing is read after "quit", so that the thread can be joined.
+			if (!tokens.empty() && tokens[0] == "quit") {
+				break;
+			}
 		}
 	});
 
+	auto searcher = chss::search::Searcher();
 	auto uciState =
 		UciState(Ready{.state = chss::fen::Parse("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1")});
 
@@ -248,12 +649,20 @@ void UCI(std::istream& in, std::ostream& out) {
 			} else if (tokens[0] == "isready") {
 				IsReadyCommand(tokens, out, uciState);
 			} else if (tokens[0] == "position") {
-				PositionCommand(tokens, out, uciState);
+				PositionCommand(tokens, out, uciState, searcher);
 			} else if (tokens[0] == "go") {
-				GoCommand(tokens, out, uciState);
+				GoCommand(tokens, out, uciState, searcher);
+			} else if (tokens[0] == "setoption") {
+				SetOptionCommand(tokens, out, uciState, searcher);
 			} else if (tokens[0] == "stop") {
-				StopCommand(tokens, out, uciState);
+				StopCommand(tokens, out, uciState, searcher);
+			} else if (tokens[0] == "ponderhit") {
+				PonderHitCommand(tokens, out, uciState);
+			} else if (tokens[0] == "ucinewgame") {
+				UciNewGameCommand(tokens, out, uciState, searcher);
 			} else if (tokens[0] == "quit") {
+				QuitCommand(uciState);
+				inputThread.join();
 				return;
 			}
 		}
@@ -262,13 +671,21 @@ void UCI(std::istream& in, std::ostream& out) {
 				[](Ready& ready){
 					// Do nothing.
 				},
-				[&out, &uciState](BestMoveCalculation& bestMoveCalculation){
-					if (bestMoveCalculation.bestMove.wait_for(std::chrono::milliseconds(0)) != std::future_status::timeout) {
-						const auto [score, move] = bestMoveCalculation.bestMove.get();
-						const auto fromStr = std::string(debug::PositionToString(move.from));
-						const auto toStr = std::string(debug::PositionToString(move.to));
-						const auto promotionStr = PromotionToString(move.promotionType);
-						out << "bestmove " << fromStr << toStr << promotionStr << std::endl;
+				[&out, &uciState, &searcher](BestMoveCalculation& bestMoveCalculation){
+					if (!bestMoveCalculation.result.has_value() &&
+						bestMoveCalculation.bestMove.wait_for(std::chrono::milliseconds(0)) != std::future_status::timeout) {
+						bestMoveCalculation.result = bestMoveCalculation.bestMove.get();
+					}
+					// After the result, so that the last reports of a finished search get printed before it.
+					PrintReportedLines(out, bestMoveCalculation);
+					if (!bestMoveCalculation.result.has_value()) {
+						if (bestMoveCalculation.deadline.has_value() &&
+							std::chrono::steady_clock::now() >= bestMoveCalculation.deadline.value()) {
+							bestMoveCalculation.stopFlag.test_and_set();
+						}
+					} else if (!bestMoveCalculation.isPondering && !bestMoveCalculation.isInfinite) {
+						const auto [score, move] = bestMoveCalculation.result.value();
+						PrintBestMove(out, searcher, bestMoveCalculation.state, score, move);
 						auto stateTmp = std::move(bestMoveCalculation).state;
 						uciState = Ready{.state = std::move(stateTmp)};
 					}
@@ -60,6 +60,16 @@ public:
 		return future;
 	}
 
+	/**
+	 * @brief Inserts a new task to be executed, like PushBack, but without a future. The caller has to know when it
+	 * ends by itself, and that it never starts if the TaskQueue is destroyed first.
+	 *
+	 * @param task Task to be executed.
+	 */
+	void PushBackWithoutFuture(std::function<void()> task) {
+		PushBackImpl(std::move(task));
+	}
+
 private:
 	void PushBackImpl(std::function<void()>&& task);
 
@@ -0,0 +1,57 @@
+#include "WorkerGroup.h"
+
+#include <cassert>
+#include <utility>
+
+namespace concurrency {
+
+WorkerGroup::WorkerGroup(int numWorkers, std::function<void(int)> job)
+	: mJob(std::move(job)) {
+	mWorkers.reserve(numWorkers);
+	for (int i = 0; i < numWorkers; ++i) {
+		mWorkers.emplace_back([this, i]() {
+			std::int64_t numRuns = 0;
+			auto uniqueLock = std::unique_lock(mMutex);
+			while (true) {
+				mStartConditionVariable.wait(uniqueLock, [&]() { return mIsBeingDestroyed || mNumRuns != numRuns; });
+				if (mIsBeingDestroyed) {
+					return;
+				}
+				numRuns = mNumRuns;
+				uniqueLock.unlock();
+				mJob(i);
+				uniqueLock.lock();
+				if (--mNumRunningWorkers == 0) {
+					mEndConditionVariable.notify_all();
+				}
+			}
+		});
+	}
+}
+
+WorkerGroup::~WorkerGroup() {
+	Wait();
+	auto uniqueLock = std::unique_lock(mMutex);
+	mIsBeingDestroyed = true;
+	uniqueLock.unlock();
+	mStartConditionVariable.notify_all();
+	for (auto& worker : mWorkers) {
+		worker.join();
+	}
+}
+
+void WorkerGroup::Start() {
+	auto uniqueLock = std::unique_lock(mMutex);
+	assert(mNumRunningWorkers == 0);
+	++mNumRuns;
+	mNumRunningWorkers = static_cast<int>(mWorkers.size());
+	uniqueLock.unlock();
+	mStartConditionVariable.notify_all();
+}
+
+void WorkerGroup::Wait() {
+	auto uniqueLock = std::unique_lock(mMutex);
+	mEndConditionVariable.wait(uniqueLock, [this]() { return mNumRunningWorkers == 0; });
+}
+
+} // namespace concurrency
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace concurrency {
+
+/**
+ * A fixed group of workers that run the same job together, once per call to Start, and wait in between.
+ * The job is given once, on construction, and each worker calls it with its own index (from 0 to numWorkers - 1).
+ * Unlike pushing one task per worker to a TaskQueue, starting a run does not allocate.
+ *
+ * Start must not be called again until Wait returns. On destruction, the WorkerGroup waits for the run in progress, if
+ * any, and joins the workers.
+ */
+class WorkerGroup {
+public:
+	WorkerGroup(int numWorkers, std::function<void(int)> job);
+	~WorkerGroup();
+
+	WorkerGroup(const WorkerGroup&) = delete;
+	WorkerGroup& operator=(const WorkerGroup&) = delete;
+	WorkerGroup(WorkerGroup&&) = delete;
+	WorkerGroup& operator=(WorkerGroup&&) = delete;
+
+	// Wakes up every worker to run the job once more.
+	void Start();
+
+	// Blocks until every worker finished the run that the last Start began.
+	void Wait();
+
+private:
+	std::function<void(int)> mJob;
+	std::mutex mMutex;
+	std::condition_variable mStartConditionVariable;
+	std::condition_variable mEndConditionVariable;
+	std::int64_t mNumRuns = 0;
+	int mNumRunningWorkers = 0;
+	bool mIsBeingDestroyed = false;
+	std::vector<std::thread> mWorkers;
+};
+
+} // namespace concurrency
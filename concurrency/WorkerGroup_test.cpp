@@ -0,0 +1,47 @@
+#include "WorkerGroup.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <atomic>
+#include <vector>
+
+TEST_CASE("WorkerGroup", "EachWorkerRunsTheJobOncePerStart") {
+	const int numWorkers = 8;
+	const int numRuns = 100;
+
+	auto runsPerWorker = std::vector<std::atomic<int>>(numWorkers);
+	auto workerGroup = concurrency::WorkerGroup(numWorkers, [&runsPerWorker](const int index) {
+		runsPerWorker[index].fetch_add(1);
+	});
+	for (int run = 1; run <= numRuns; ++run) {
+		workerGroup.Start();
+		workerGroup.Wait();
+		// Wait returns once every worker is done, so all of them have run exactly this many times.
+		for (const auto& runs : runsPerWorker) {
+			REQUIRE(runs.load() == run);
+		}
+	}
+}
+
+TEST_CASE("WorkerGroup", "Start_DoesNotWaitForTheWorkers") {
+	auto isReleased = std::atomic<bool>(false);
+	auto workerGroup = concurrency::WorkerGroup(2, [&isReleased](int) {
+		while (!isReleased.load()) {
+			isReleased.wait(false);
+		}
+	});
+	workerGroup.Start();
+	// The workers only finish once the caller releases them, after Start returned.
+	isReleased.store(true);
+	isReleased.notify_all();
+	workerGroup.Wait();
+}
+
+TEST_CASE("WorkerGroup", "OnDestruction_WaitsForTheRun") {
+	auto numFinishedWorkers = std::atomic<int>(0);
+	{
+		auto workerGroup = concurrency::WorkerGroup(4, [&numFinishedWorkers](int) { numFinishedWorkers.fetch_add(1); });
+		workerGroup.Start();
+	}
+	REQUIRE(numFinishedWorkers.load() == 4);
+}
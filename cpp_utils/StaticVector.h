@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace cpp_utils {
+
+/**
+ * A vector with a fixed capacity that lives entirely in its own storage (no heap allocations).
+ * Meant for small bounded lists (moves, attackers, ...) that have to be usable in constexpr code.
+ */
+template<typename T, std::size_t N>
+class StaticVector {
+public:
+	constexpr StaticVector()
+		: mData()
+		, mSize(0) {}
+
+	constexpr void PushBack(const T& value) {
+		assert(mSize < N);
+		mData[mSize] = value;
+		++mSize;
+	}
+
+	constexpr void PopBack() {
+		assert(mSize > 0);
+		--mSize;
+	}
+
+	constexpr void Clear() {
+		mSize = 0;
+	}
+
+	[[nodiscard]] constexpr T& operator[](std::size_t index) {
+		assert(index < mSize);
+		return mData[index];
+	}
+
+	[[nodiscard]] constexpr const T& operator[](std::size_t index) const {
+		assert(index < mSize);
+		return mData[index];
+	}
+
+	[[nodiscard]] constexpr std::size_t GetSize() const {
+		return mSize;
+	}
+
+	[[nodiscard]] constexpr bool IsEmpty() const {
+		return mSize == 0;
+	}
+
+	[[nodiscard]] static constexpr std::size_t GetCapacity() {
+		return N;
+	}
+
+	[[nodiscard]] constexpr auto begin() {
+		return mData.begin();
+	}
+
+	[[nodiscard]] constexpr auto begin() const {
+		return mData.begin();
+	}
+
+	[[nodiscard]] constexpr auto end() {
+		return mData.begin() + mSize;
+	}
+
+	[[nodiscard]] constexpr auto end() const {
+		return mData.begin() + mSize;
+	}
+
+private:
+	std::array<T, N> mData;
+	std::size_t mSize;
+};
+
+} // namespace cpp_utils
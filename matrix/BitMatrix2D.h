@@ -0,0 +1,223 @@
+#pragma once
+
+#include "Matrix2D.h"
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+namespace detail {
+
+// The bits of the columns firstX to lastX, included, of every row of a matrix of size S packed row by row.
+template<matrix::Size2D S>
+[[nodiscard]] constexpr std::uint64_t ColumnsMask(const int firstX, const int lastX) {
+	std::uint64_t mask = 0;
+	for (int y = 0; y < S.sizeY; ++y) {
+		for (int x = firstX; x <= lastX; ++x) {
+			mask |= std::uint64_t{1} << (y * S.sizeX + x);
+		}
+	}
+	return mask;
+}
+
+// Swaps the bits of the mask with the bits `shift` positions above them.
+[[nodiscard]] constexpr std::uint64_t DeltaSwap(const std::uint64_t bits, const std::uint64_t mask, const int shift) {
+	const auto delta = ((bits >> shift) ^ bits) & mask;
+	return bits ^ delta ^ (delta << shift);
+}
+
+} // namespace detail
+
+namespace matrix {
+
+/**
+ * A matrix of bits packed in an integer, with the bit y * S.sizeX + x for the position {y, x}: the sets of positions
+ * can be intersected, shifted, counted or mirrored at once instead of position by position.
+ */
+template<Size2D S>
+class BitMatrix2D {
+	static_assert(0 < S.sizeY && 0 < S.sizeX && S.sizeY * S.sizeX <= 64);
+
+public:
+	static constexpr std::uint64_t kAllBits =
+		S.sizeY * S.sizeX == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << (S.sizeY * S.sizeX)) - 1;
+
+	// The bits out of the matrix are dropped.
+	constexpr explicit BitMatrix2D(const std::uint64_t bits)
+		: mBits(bits & kAllBits) {}
+
+	constexpr explicit BitMatrix2D()
+		: mBits(0) {}
+
+	[[nodiscard]] static constexpr BitMatrix2D Full() {
+		return BitMatrix2D(kAllBits);
+	}
+
+	[[nodiscard]] constexpr bool At(const Position2D& pos) const {
+		return (mBits & Bit(pos)) != 0;
+	}
+
+	constexpr void Set(const Position2D& pos, const bool value) {
+		mBits = value ? mBits | Bit(pos) : mBits & ~Bit(pos);
+	}
+
+	[[nodiscard]] constexpr Size2D GetSize() const {
+		return S;
+	}
+
+	[[nodiscard]] constexpr bool IsInside(const Position2D& position) const {
+		return matrix::IsInside(S, position);
+	}
+
+	[[nodiscard]] constexpr std::uint64_t GetBits() const {
+		return mBits;
+	}
+
+	[[nodiscard]] constexpr bool IsEmpty() const {
+		return mBits == 0;
+	}
+
+	[[nodiscard]] constexpr int PopCount() const {
+		return std::popcount(mBits);
+	}
+
+	// The set position with the lowest index (row by row). The matrix must not be empty.
+	[[nodiscard]] constexpr Position2D FirstPosition() const {
+		assert(!IsEmpty());
+		return ToPosition(std::countr_zero(mBits));
+	}
+
+	// The set position with the highest index (row by row). The matrix must not be empty.
+	[[nodiscard]] constexpr Position2D LastPosition() const {
+		assert(!IsEmpty());
+		return ToPosition(63 - std::countl_zero(mBits));
+	}
+
+	// Every set position moved by the direction. The ones that leave the matrix are dropped, instead of wrapping around
+	// to the next row.
+	[[nodiscard]] constexpr BitMatrix2D Shift(const Direction2D& direction) const {
+		if (direction.deltaY <= -S.sizeY || S.sizeY <= direction.deltaY || direction.deltaX <= -S.sizeX ||
+			S.sizeX <= direction.deltaX) {
+			return BitMatrix2D();
+		}
+		auto bits = mBits;
+		if (direction.deltaX > 0) {
+			bits &= detail::ColumnsMask<S>(0, S.sizeX - 1 - direction.deltaX);
+		} else if (direction.deltaX < 0) {
+			bits &= detail::ColumnsMask<S>(-direction.deltaX, S.sizeX - 1);
+		}
+		const auto shift = direction.deltaY * S.sizeX + direction.deltaX;
+		return BitMatrix2D(shift >= 0 ? bits << shift : bits >> -shift);
+	}
+
+	[[nodiscard]] constexpr BitMatrix2D operator~() const {
+		return BitMatrix2D(~mBits);
+	}
+
+	[[nodiscard]] constexpr BitMatrix2D operator&(const BitMatrix2D& other) const {
+		return BitMatrix2D(mBits & other.mBits);
+	}
+
+	[[nodiscard]] constexpr BitMatrix2D operator|(const BitMatrix2D& other) const {
+		return BitMatrix2D(mBits | other.mBits);
+	}
+
+	[[nodiscard]] constexpr BitMatrix2D operator^(const BitMatrix2D& other) const {
+		return BitMatrix2D(mBits ^ other.mBits);
+	}
+
+	constexpr BitMatrix2D& operator&=(const BitMatrix2D& other) {
+		mBits &= other.mBits;
+		return *this;
+	}
+
+	constexpr BitMatrix2D& operator|=(const BitMatrix2D& other) {
+		mBits |= other.mBits;
+		return *this;
+	}
+
+	constexpr BitMatrix2D& operator^=(const BitMatrix2D& other) {
+		mBits ^= other.mBits;
+		return *this;
+	}
+
+	[[nodiscard]] constexpr bool operator==(const BitMatrix2D& other) const = default;
+
+private:
+	[[nodiscard]] static constexpr std::uint64_t Bit(const Position2D& pos) {
+		assert(0 <= pos.y && pos.y < S.sizeY);
+		assert(0 <= pos.x && pos.x < S.sizeX);
+		return std::uint64_t{1} << (pos.y * S.sizeX + pos.x);
+	}
+
+	[[nodiscard]] static constexpr Position2D ToPosition(const int index) {
+		return Position2D{.y = index / S.sizeX, .x = index % S.sizeX};
+	}
+
+	std::uint64_t mBits;
+};
+
+// The same operations as for Matrix2D. The 8x8 matrices swap the bytes and the bits of the rows with masks, the other
+// sizes move a row, a column or a bit at a time.
+
+template<Size2D S>
+[[nodiscard]] constexpr BitMatrix2D<S> FlipVertical(const BitMatrix2D<S>& matrix) {
+	auto bits = matrix.GetBits();
+	if constexpr (S == Size2D{.sizeY = 8, .sizeX = 8}) {
+		bits = detail::DeltaSwap(bits, 0x00FF00FF00FF00FFULL, 8);
+		bits = detail::DeltaSwap(bits, 0x0000FFFF0000FFFFULL, 16);
+		return BitMatrix2D<S>((bits >> 32) | (bits << 32));
+	} else {
+		constexpr auto kRowMask = (std::uint64_t{1} << S.sizeX) - 1;
+		std::uint64_t result = 0;
+		for (int y = 0; y < S.sizeY; ++y) {
+			result |= ((bits >> (y * S.sizeX)) & kRowMask) << ((S.sizeY - 1 - y) * S.sizeX);
+		}
+		return BitMatrix2D<S>(result);
+	}
+}
+
+template<Size2D S>
+[[nodiscard]] constexpr BitMatrix2D<S> FlipHorizontal(const BitMatrix2D<S>& matrix) {
+	auto bits = matrix.GetBits();
+	if constexpr (S == Size2D{.sizeY = 8, .sizeX = 8}) {
+		bits = detail::DeltaSwap(bits, 0x5555555555555555ULL, 1);
+		bits = detail::DeltaSwap(bits, 0x3333333333333333ULL, 2);
+		return BitMatrix2D<S>(detail::DeltaSwap(bits, 0x0F0F0F0F0F0F0F0FULL, 4));
+	} else {
+		std::uint64_t result = 0;
+		for (int x = 0; x < S.sizeX; ++x) {
+			const auto column = bits & detail::ColumnsMask<S>(x, x);
+			const auto shift = S.sizeX - 1 - 2 * x;
+			result |= shift >= 0 ? column << shift : column >> -shift;
+		}
+		return BitMatrix2D<S>(result);
+	}
+}
+
+template<Size2D S>
+[[nodiscard]] constexpr BitMatrix2D<Size2D{.sizeY = S.sizeX, .sizeX = S.sizeY}> Transpose(const BitMatrix2D<S>& m) {
+	constexpr auto ST = Size2D{.sizeY = S.sizeX, .sizeX = S.sizeY};
+	auto bits = m.GetBits();
+	if constexpr (S == Size2D{.sizeY = 8, .sizeX = 8}) {
+		// Swaps the 4x4 blocks above and below the diagonal, then the 2x2 blocks in them, then the bits.
+		bits = detail::DeltaSwap(bits, 0x00000000F0F0F0F0ULL, 28);
+		bits = detail::DeltaSwap(bits, 0x0000CCCC0000CCCCULL, 14);
+		return BitMatrix2D<ST>(detail::DeltaSwap(bits, 0x00AA00AA00AA00AAULL, 7));
+	} else {
+		auto result = BitMatrix2D<ST>();
+		for (; bits != 0; bits &= bits - 1) {
+			const auto index = std::countr_zero(bits);
+			result.Set(Position2D{.y = index % S.sizeX, .x = index / S.sizeX}, true);
+		}
+		return result;
+	}
+}
+
+template<Size2D S>
+[[nodiscard]] constexpr BitMatrix2D<Size2D{.sizeY = S.sizeX, .sizeX = S.sizeY}> RotateClockwise(
+	const BitMatrix2D<S>& matrix) {
+	return FlipHorizontal(Transpose(matrix));
+}
+
+} // namespace matrix
@@ -0,0 +1,136 @@
+#include "BitMatrix2D.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <cstdint>
+
+namespace {
+
+constexpr auto kSize = matrix::Size2D{.sizeY = 8, .sizeX = 8};
+constexpr auto kOddSize = matrix::Size2D{.sizeY = 3, .sizeX = 5};
+
+template<matrix::Size2D S>
+[[nodiscard]] constexpr matrix::Matrix2D<bool, S> ToMatrix(const matrix::BitMatrix2D<S>& bitMatrix) {
+	auto result = matrix::Matrix2D<bool, S>();
+	for (const auto position : matrix::ForEach(S)) {
+		result.At(position) = bitMatrix.At(position);
+	}
+	return result;
+}
+
+// Whether the operation on the bit matrices gives the same as on the matrices of bools, for every single position and
+// for a few sets of positions.
+template<matrix::Size2D S, typename BitOperation, typename Operation>
+[[nodiscard]] constexpr bool IsSameAsMatrix2D(const BitOperation& bitOperation, const Operation& operation) {
+	for (int i = 0; i < S.sizeY * S.sizeX; ++i) {
+		const auto bitMatrix = matrix::BitMatrix2D<S>(std::uint64_t{1} << i);
+		if (ToMatrix(bitOperation(bitMatrix)) != operation(ToMatrix(bitMatrix))) {
+			return false;
+		}
+	}
+	for (const std::uint64_t bits : {0x0123456789ABCDEFULL, 0xF00DCAFE12345678ULL, ~0ULL}) {
+		const auto bitMatrix = matrix::BitMatrix2D<S>(bits);
+		if (ToMatrix(bitOperation(bitMatrix)) != operation(ToMatrix(bitMatrix))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<matrix::Size2D S>
+[[nodiscard]] constexpr bool AreTheTransformsSameAsMatrix2D() {
+	// The same generic lambdas call the overloads of both kinds of matrices.
+	const auto flipVertical = [](const auto& m) { return matrix::FlipVertical(m); };
+	const auto flipHorizontal = [](const auto& m) { return matrix::FlipHorizontal(m); };
+	const auto transpose = [](const auto& m) { return matrix::Transpose(m); };
+	const auto rotateClockwise = [](const auto& m) { return matrix::RotateClockwise(m); };
+	return IsSameAsMatrix2D<S>(flipVertical, flipVertical) && IsSameAsMatrix2D<S>(flipHorizontal, flipHorizontal) &&
+		IsSameAsMatrix2D<S>(transpose, transpose) && IsSameAsMatrix2D<S>(rotateClockwise, rotateClockwise);
+}
+
+// Whether the shift moves every position by the direction, and drops the ones that leave the matrix.
+template<matrix::Size2D S>
+[[nodiscard]] constexpr bool IsShiftSameAsMovingEachPosition(const matrix::Direction2D& direction) {
+	for (int i = 0; i < S.sizeY * S.sizeX; ++i) {
+		const auto bitMatrix = matrix::BitMatrix2D<S>(std::uint64_t{1} << i);
+		const auto to = bitMatrix.FirstPosition() + direction;
+		auto expected = matrix::BitMatrix2D<S>();
+		if (matrix::IsInside(S, to)) {
+			expected.Set(to, true);
+		}
+		if (bitMatrix.Shift(direction) != expected) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<matrix::Size2D S>
+[[nodiscard]] constexpr bool AreShiftsSameAsMovingEachPosition() {
+	for (int deltaY = -S.sizeY; deltaY <= S.sizeY; ++deltaY) {
+		for (int deltaX = -S.sizeX; deltaX <= S.sizeX; ++deltaX) {
+			if (!IsShiftSameAsMovingEachPosition<S>(matrix::Direction2D{.deltaY = deltaY, .deltaX = deltaX})) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+TEST_CASE("BitMatrix2D", "Constructors") {
+	STATIC_REQUIRE(matrix::BitMatrix2D<kSize>().IsEmpty());
+	STATIC_REQUIRE(matrix::BitMatrix2D<kSize>::Full().PopCount() == 64);
+	STATIC_REQUIRE(matrix::BitMatrix2D<kOddSize>::Full().PopCount() == 15);
+	// The bits out of the matrix are dropped.
+	STATIC_REQUIRE(matrix::BitMatrix2D<kOddSize>(~std::uint64_t{0}) == matrix::BitMatrix2D<kOddSize>::Full());
+}
+
+TEST_CASE("BitMatrix2D", "AtAndSet") {
+	constexpr auto bitMatrix = [] {
+		auto result = matrix::BitMatrix2D<kOddSize>();
+		result.Set(matrix::Position2D{.y = 1, .x = 3}, true);
+		result.Set(matrix::Position2D{.y = 2, .x = 0}, true);
+		result.Set(matrix::Position2D{.y = 2, .x = 0}, false);
+		return result;
+	}();
+	STATIC_REQUIRE(bitMatrix.At(matrix::Position2D{.y = 1, .x = 3}));
+	STATIC_REQUIRE(!bitMatrix.At(matrix::Position2D{.y = 2, .x = 0}));
+	STATIC_REQUIRE(bitMatrix.GetBits() == std::uint64_t{1} << 8);
+	STATIC_REQUIRE(bitMatrix.GetSize() == kOddSize);
+	STATIC_REQUIRE(bitMatrix.IsInside(matrix::Position2D{.y = 2, .x = 4}));
+	STATIC_REQUIRE(!bitMatrix.IsInside(matrix::Position2D{.y = 3, .x = 0}));
+}
+
+TEST_CASE("BitMatrix2D", "PopCountAndBitScan") {
+	constexpr auto bitMatrix = matrix::BitMatrix2D<kSize>(0x0000100000000400ULL);
+	STATIC_REQUIRE(bitMatrix.PopCount() == 2);
+	STATIC_REQUIRE(bitMatrix.FirstPosition() == matrix::Position2D{.y = 1, .x = 2});
+	STATIC_REQUIRE(bitMatrix.LastPosition() == matrix::Position2D{.y = 5, .x = 4});
+}
+
+TEST_CASE("BitMatrix2D", "SetOperations") {
+	constexpr auto a = matrix::BitMatrix2D<kOddSize>(0b1100);
+	constexpr auto b = matrix::BitMatrix2D<kOddSize>(0b1010);
+	STATIC_REQUIRE((a & b).GetBits() == 0b1000);
+	STATIC_REQUIRE((a | b).GetBits() == 0b1110);
+	STATIC_REQUIRE((a ^ b).GetBits() == 0b0110);
+	STATIC_REQUIRE((~a).PopCount() == 13);
+	STATIC_REQUIRE(a != b);
+}
+
+TEST_CASE("BitMatrix2D", "Shift_MovesEachPositionAndDropsTheOnesThatLeave") {
+	STATIC_REQUIRE(AreShiftsSameAsMovingEachPosition<kOddSize>());
+	STATIC_REQUIRE(IsShiftSameAsMovingEachPosition<kSize>(matrix::Direction2D{.deltaY = 1, .deltaX = 0}));
+	STATIC_REQUIRE(IsShiftSameAsMovingEachPosition<kSize>(matrix::Direction2D{.deltaY = -1, .deltaX = -1}));
+	STATIC_REQUIRE(IsShiftSameAsMovingEachPosition<kSize>(matrix::Direction2D{.deltaY = 2, .deltaX = -1}));
+	STATIC_REQUIRE(IsShiftSameAsMovingEachPosition<kSize>(matrix::Direction2D{.deltaY = -1, .deltaX = 2}));
+	STATIC_REQUIRE(IsShiftSameAsMovingEachPosition<kSize>(matrix::Direction2D{.deltaY = 0, .deltaX = 7}));
+	STATIC_REQUIRE(IsShiftSameAsMovingEachPosition<kSize>(matrix::Direction2D{.deltaY = 8, .deltaX = 0}));
+}
+
+TEST_CASE("BitMatrix2D", "Transforms_SameAsMatrix2D") {
+	STATIC_REQUIRE(AreTheTransformsSameAsMatrix2D<kSize>());
+	STATIC_REQUIRE(AreTheTransformsSameAsMatrix2D<kOddSize>());
+}
@@ -2,6 +2,8 @@
 
 #include <test_utils/TestUtils.h>
 
+#include <utility>
+
 TEST_CASE("Matrix2D", "Position2D_Comparison") {
 	constexpr auto pos1 = matrix::Position2D{.y = 1, .x = 2};
 	constexpr auto pos2 = matrix::Position2D{.y = 1, .x = 2};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Matrix2D.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace matrix {
+
+/**
+ * A Matrix2D surrounded by kPadding.sizeY rows above and below it and kPadding.sizeX columns on each side, which hold
+ * kBorder. At also reads the positions of the padding, so that a walk through the matrix can stop on kBorder instead of
+ * checking IsInside at every step.
+ * The rows are stored one after the other, so the columns on the right of a row and the ones on the left of the next
+ * row are next to each other: a step of up to 2 * kPadding.sizeX columns out of the matrix still lands on the padding.
+ */
+template<typename T, Size2D S, Size2D kPadding, const T& kBorder>
+class PaddedMatrix2D {
+	static constexpr auto kPaddedSize =
+		Size2D{.sizeY = S.sizeY + 2 * kPadding.sizeY, .sizeX = S.sizeX + 2 * kPadding.sizeX};
+
+public:
+	constexpr explicit PaddedMatrix2D(const std::array<T, S.sizeY * S.sizeX>& data)
+		: mData(detail::CreateFilledArray<T, kPaddedSize.sizeY * kPaddedSize.sizeX>(kBorder)) {
+		for (int y = 0; y < S.sizeY; ++y) {
+			for (int x = 0; x < S.sizeX; ++x) {
+				At(Position2D{.y = y, .x = x}) = data[y * S.sizeX + x];
+			}
+		}
+	}
+
+	constexpr explicit PaddedMatrix2D(const T& value)
+		: PaddedMatrix2D(detail::CreateFilledArray<T, S.sizeY * S.sizeX>(value)) {}
+
+	constexpr explicit PaddedMatrix2D()
+		: PaddedMatrix2D(T()) {}
+
+	// The position can be out of the matrix, on its padding.
+	[[nodiscard]] constexpr T& At(const Position2D& pos) {
+		return mData[PaddedIndex(pos)];
+	}
+
+	[[nodiscard]] constexpr const T& At(const Position2D& pos) const {
+		return mData[PaddedIndex(pos)];
+	}
+
+	[[nodiscard]] constexpr Size2D GetSize() const {
+		return S;
+	}
+
+	[[nodiscard]] constexpr bool IsInside(const Position2D& position) const {
+		return matrix::IsInside(S, position);
+	}
+
+	[[nodiscard]] constexpr bool operator==(const PaddedMatrix2D& other) const = default;
+
+private:
+	[[nodiscard]] static constexpr std::size_t PaddedIndex(const Position2D& pos) {
+		assert(-kPadding.sizeY <= pos.y && pos.y < S.sizeY + kPadding.sizeY);
+		assert(-2 * kPadding.sizeX <= pos.x && pos.x < S.sizeX + 2 * kPadding.sizeX);
+		const auto index = (pos.y + kPadding.sizeY) * kPaddedSize.sizeX + pos.x + kPadding.sizeX;
+		assert(0 <= index && index < kPaddedSize.sizeY * kPaddedSize.sizeX);
+		return static_cast<std::size_t>(index);
+	}
+
+	std::array<T, kPaddedSize.sizeY * kPaddedSize.sizeX> mData;
+};
+
+} // namespace matrix
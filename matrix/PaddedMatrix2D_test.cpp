@@ -0,0 +1,70 @@
+#include "PaddedMatrix2D.h"
+
+#include <test_utils/TestUtils.h>
+
+#include <utility>
+
+namespace {
+
+constexpr int kBorder = -1;
+constexpr auto kSize = matrix::Size2D{.sizeY = 2, .sizeX = 3};
+constexpr auto kPadding = matrix::Size2D{.sizeY = 2, .sizeX = 1};
+
+using PaddedMatrix = matrix::PaddedMatrix2D<int, kSize, kPadding, kBorder>;
+
+} // namespace
+
+TEST_CASE("PaddedMatrix2D", "ArrayConstructor") {
+	constexpr auto matrix = PaddedMatrix(std::array<int, 6>{1, 2, 3, 4, 5, 6});
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 0, .x = 0}) == 1);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 0, .x = 1}) == 2);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 0, .x = 2}) == 3);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 1, .x = 0}) == 4);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 1, .x = 1}) == 5);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 1, .x = 2}) == 6);
+}
+
+TEST_CASE("PaddedMatrix2D", "ValueAndDefaultConstructors") {
+	constexpr auto matrix = PaddedMatrix(1234);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 0, .x = 0}) == 1234);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 1, .x = 2}) == 1234);
+	constexpr auto defaultMatrix = PaddedMatrix();
+	STATIC_REQUIRE(defaultMatrix.At(matrix::Position2D{.y = 0, .x = 0}) == 0);
+	STATIC_REQUIRE(defaultMatrix.At(matrix::Position2D{.y = 1, .x = 2}) == 0);
+}
+
+TEST_CASE("PaddedMatrix2D", "At_ThePaddingHoldsTheBorder") {
+	constexpr auto matrix = PaddedMatrix(1234);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = -1, .x = 0}) == kBorder);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = -2, .x = -1}) == kBorder);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 3, .x = 3}) == kBorder);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 0, .x = -1}) == kBorder);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 1, .x = 3}) == kBorder);
+	// Two columns out of the matrix land on the padding of the next or of the previous row.
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 0, .x = -2}) == kBorder);
+	STATIC_REQUIRE(matrix.At(matrix::Position2D{.y = 1, .x = 4}) == kBorder);
+}
+
+TEST_CASE("PaddedMatrix2D", "At") {
+	constexpr auto pos = matrix::Position2D{.y = 0, .x = 0};
+	auto matrix = PaddedMatrix();
+	STATIC_REQUIRE(std::is_same_v<decltype(matrix.At(pos)), int&>);
+	STATIC_REQUIRE(std::is_same_v<decltype(std::as_const(matrix).At(pos)), const int&>);
+}
+
+TEST_CASE("PaddedMatrix2D", "GetSizeAndIsInside") {
+	constexpr auto matrix = PaddedMatrix();
+	STATIC_REQUIRE(matrix.GetSize() == kSize);
+	STATIC_REQUIRE(matrix.IsInside(matrix::Position2D{.y = 0, .x = 0}));
+	STATIC_REQUIRE(matrix.IsInside(matrix::Position2D{.y = 1, .x = 2}));
+	STATIC_REQUIRE(!matrix.IsInside(matrix::Position2D{.y = -1, .x = 0}));
+	STATIC_REQUIRE(!matrix.IsInside(matrix::Position2D{.y = 0, .x = 3}));
+}
+
+TEST_CASE("PaddedMatrix2D", "Comparison") {
+	constexpr auto matrix1 = PaddedMatrix(123);
+	constexpr auto matrix2 = PaddedMatrix(123);
+	constexpr auto matrix3 = PaddedMatrix(456);
+	STATIC_REQUIRE(matrix1 == matrix2);
+	STATIC_REQUIRE(matrix1 != matrix3);
+}